@@ -0,0 +1,18 @@
+#ifndef BENCH_THREADS_H
+#define BENCH_THREADS_H
+
+#include <thread>
+
+// 伸缩性测试的线程数依次取 1, 2, 4 ... max，max 不是 2 的幂时最后测 max 本身：
+// for (unsigned t = 1; t <= max; t = next_thread_count(t, max))
+// hardware_concurrency 可能返回 0，此时按 1 个线程处理
+inline unsigned max_bench_threads() {
+    const unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+inline unsigned next_thread_count(unsigned t, unsigned max) {
+    return t != max && (t << 1) > max ? max : t << 1;
+}
+
+#endif
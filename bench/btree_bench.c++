@@ -0,0 +1,74 @@
+// btree_map 与 map (红黑树) 的对比：随机插入、随机查找、顺序遍历、每个元素占用的内存
+// 内存只计节点本身，不含 malloc 的额外开销 (红黑树每个节点单独分配，这部分开销更大)
+// g++ -O2 -std=c++17 -I../include btree_bench.c++ -o btree_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "map.h"
+#include "btree_map.h"
+#include "random.h"
+using namespace mystl;
+
+typedef pair<unsigned, unsigned> value_t;
+
+static double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+template <class Map>
+static size_t memory_of(Map& m) { return m.memory_usage(); }
+
+// 红黑树每个元素一个节点
+template <class K, class V>
+static size_t memory_of(map<K, V>& m) { return sizeof(rb_tree_node<pair<K, V>>) * m.size(); }
+
+template <class Map>
+static void run(const char* name, const unsigned* keys, const unsigned* probes, int n) {
+    Map m;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        m.insert(value_t(keys[i], i));
+    const double t_insert = ms_since(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    unsigned long hit = 0;
+    for (int i = 0; i < n; ++i) {
+        auto it = m.find(probes[i]);
+        if (it != m.end()) hit += (*it).second;
+    }
+    const double t_find = ms_since(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    unsigned long sum = 0;
+    for (auto it = m.begin(); it != m.end(); ++it)
+        sum += (*it).first;
+    const double t_scan = ms_since(t0);
+
+    const size_t bytes = memory_of(m);
+    printf("%-18s insert %9.2f ms  find %9.2f ms  scan %8.2f ms  %6.1f B/entry  (%lu %lu)\n",
+           name, t_insert, t_find, t_scan, static_cast<double>(bytes) / m.size(), hit, sum);
+}
+
+int main(int argc, char** argv) {
+    const int n = argc > 1 ? atoi(argv[1]) : 1 << 22;
+    unsigned* keys = new unsigned[n];
+    unsigned* probes = new unsigned[n];
+    xorshift32 rng(2024);
+    for (int i = 0; i < n; ++i) keys[i] = rng();
+    // 一半命中，一半随机
+    for (int i = 0; i < n; ++i) probes[i] = (i & 1) ? keys[rng(static_cast<unsigned>(n))] : rng();
+
+    // 先空跑一次，让堆内存完成缺页，避免第一组计时偏大
+    {
+        map<unsigned, unsigned> warm;
+        for (int i = 0; i < n; ++i) warm.insert(value_t(keys[i], i));
+    }
+    printf("%d random keys, pair<unsigned, unsigned> values\n", n);
+    run<map<unsigned, unsigned>>("map (rb_tree)", keys, probes, n);
+    run<btree_map<unsigned, unsigned, less<unsigned>, 128>>("btree_map<128>", keys, probes, n);
+    run<btree_map<unsigned, unsigned, less<unsigned>, 256>>("btree_map<256>", keys, probes, n);
+    run<btree_map<unsigned, unsigned, less<unsigned>, 1024>>("btree_map<1024>", keys, probes, n);
+    run<btree_map<unsigned, unsigned, less<unsigned>, 4096>>("btree_map<4096>", keys, probes, n);
+    delete[] probes;
+    delete[] keys;
+}
@@ -0,0 +1,68 @@
+// 竞争基准：concurrent_stack 与 mutex + mystl::stack 作为共享对象池
+// 加锁的一方以 vector 为底层容器，容量稳定后 push / pop 不再分配内存，只比较同步开销
+// g++ -O2 -std=c++17 -pthread -I../include concurrent_stack_bench.c++ -o concurrent_stack_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <assert.h>
+#include "allocator.h"
+#include "stack.h"
+#include "vector.h"
+#include "concurrent_stack.h"
+#include "bench_threads.h"
+using namespace mystl;
+
+struct locked_stack {
+    std::mutex                  mtx;
+    stack<int, vector<int>>     s;
+
+    void push(int x) {
+        std::lock_guard<std::mutex> lock(mtx);
+        s.push(x);
+    }
+    bool pop(int& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (s.size() == 0) return false;
+        out = s.top();
+        s.pop();
+        return true;
+    }
+};
+
+// 每个线程反复 "借出 / 归还" 对象：pop 一个，再 push 回去
+template <class Stack>
+static double run(Stack& st, unsigned threads, long ops) {
+    for (int i = 0; i < 1024; ++i) st.push(i);
+    auto start = std::chrono::steady_clock::now();
+    std::thread* ths = new std::thread[threads];
+    for (unsigned t = 0; t < threads; ++t) {
+        ths[t] = std::thread([&st, ops] {
+            int v = 0;
+            for (long i = 0; i < ops; ++i) {
+                if (st.pop(v)) st.push(v);
+                else st.push(static_cast<int>(i));
+            }
+        });
+    }
+    for (unsigned t = 0; t < threads; ++t) ths[t].join();
+    delete[] ths;
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    const long ops = argc > 1 ? atol(argv[1]) : 1000000;
+    unsigned max_threads = max_bench_threads();
+    if (max_threads < 8) max_threads = 8;
+
+    printf("threads  lock-free ms  mutex ms   (%ld pop+push per thread)\n", ops);
+    for (unsigned t = 1; t <= max_threads; t = next_thread_count(t, max_threads)) {
+        concurrent_stack<int> a;
+        locked_stack b;
+        double ta = run(a, t, ops);
+        double tb = run(b, t, ops);
+        size_t drained = a.pop_all([](int&) {});
+        printf("%7u  %12.2f  %8.2f   (drained %zu)\n", t, ta, tb, drained);
+    }
+}
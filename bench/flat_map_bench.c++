@@ -0,0 +1,70 @@
+// 读多写少的查表场景：flat_map 与 map (红黑树) 的批量构造、随机查找和每个元素的内存对比
+// 内存只计元素或节点本身，不含 malloc 的额外开销 (字符串键超出 SSO 的部分也不计)
+// 另测一组字符串键，模拟按名字查找的配置表 / 路由表
+// g++ -O2 -std=c++17 -I../include flat_map_bench.c++ -o flat_map_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include "map.h"
+#include "flat_map.h"
+#include "random.h"
+using namespace mystl;
+
+typedef pair<unsigned, unsigned> value_t;
+typedef pair<std::string, unsigned> str_value_t;
+
+static double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+template <class Map, class Value, class Key>
+static void run(const char* name, const Value* values, const Key* probes, int n, size_t bytes_per_entry) {
+    auto t0 = std::chrono::steady_clock::now();
+    Map m(values, values + n);
+    const double t_build = ms_since(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    unsigned long hit = 0;
+    for (int i = 0; i < n; ++i) {
+        auto it = m.find(probes[i]);
+        if (it != m.end()) hit += (*it).second;
+    }
+    const double t_find = ms_since(t0);
+
+    printf("%-14s build %9.2f ms  find %9.2f ms  %5zu B/entry  (%lu)\n",
+           name, t_build, t_find, bytes_per_entry, hit);
+}
+
+int main(int argc, char** argv) {
+    const int n = argc > 1 ? atoi(argv[1]) : 1 << 21;
+    value_t* values = new value_t[n];
+    unsigned* probes = new unsigned[n];
+    xorshift32 rng(4242);
+    for (int i = 0; i < n; ++i) values[i] = value_t(rng(), i);
+    // 一半命中，一半随机
+    for (int i = 0; i < n; ++i) probes[i] = (i & 1) ? values[rng(static_cast<unsigned>(n))].first : rng();
+
+    printf("%d random keys, pair<unsigned, unsigned> values\n", n);
+    run<map<unsigned, unsigned>>("map (rb_tree)", values, probes, n, sizeof(rb_tree_node<value_t>));
+    run<flat_map<unsigned, unsigned>>("flat_map", values, probes, n, sizeof(value_t));
+
+    // 字符串键：同样的随机数格式化成形如 "/api/v1/route/1a2b3c4d" 的路径
+    str_value_t* str_values = new str_value_t[n];
+    std::string* str_probes = new std::string[n];
+    char buf[32];
+    for (int i = 0; i < n; ++i) {
+        snprintf(buf, sizeof(buf), "/api/v1/route/%08x", values[i].first);
+        str_values[i] = str_value_t(buf, values[i].second);
+        snprintf(buf, sizeof(buf), "/api/v1/route/%08x", probes[i]);
+        str_probes[i] = buf;
+    }
+    printf("%d random keys, pair<std::string, unsigned> values\n", n);
+    run<map<std::string, unsigned>>("map (rb_tree)", str_values, str_probes, n, sizeof(rb_tree_node<str_value_t>));
+    run<flat_map<std::string, unsigned>>("flat_map", str_values, str_probes, n, sizeof(str_value_t));
+
+    delete[] str_probes;
+    delete[] str_values;
+    delete[] probes;
+    delete[] values;
+}
@@ -0,0 +1,61 @@
+// fork-join 基准：并行 fib 与并行求和，线程数从 1 递增到硬件核数
+// g++ -O2 -std=c++17 -pthread -I../include fork_join_bench.c++ -o fork_join_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include "thread_pool.h"
+#include "bench_threads.h"
+using namespace mystl;
+
+static long fib_seq(int n) { return n < 2 ? n : fib_seq(n - 1) + fib_seq(n - 2); }
+
+static long fib_par(thread_pool& pool, int n) {
+    if (n < 20) return fib_seq(n);
+    long a = 0;
+    task_group g(pool);
+    g.run([&] { a = fib_par(pool, n - 1); });
+    long b = fib_par(pool, n - 2);
+    g.wait();
+    return a + b;
+}
+
+static long sum_par(thread_pool& pool, const int* first, size_t n) {
+    if (n <= 16384) {
+        long s = 0;
+        for (size_t i = 0; i < n; ++i) s += first[i];
+        return s;
+    }
+    long left = 0;
+    task_group g(pool);
+    g.run([&] { left = sum_par(pool, first, n / 2); });
+    long right = sum_par(pool, first + n / 2, n - n / 2);
+    g.wait();
+    return left + right;
+}
+
+template <class F>
+static double time_ms(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    const int fib_n = argc > 1 ? atoi(argv[1]) : 34;
+    const size_t sum_n = argc > 2 ? strtoul(argv[2], nullptr, 10) : (size_t(1) << 26);
+    const unsigned max_threads = max_bench_threads();
+
+    int* data = new int[sum_n];
+    for (size_t i = 0; i < sum_n; ++i) data[i] = static_cast<int>(i & 1023);
+
+    printf("threads  fib(%d) ms  sum(%zu) ms\n", fib_n, sum_n);
+    for (unsigned t = 1; t <= max_threads; t = next_thread_count(t, max_threads)) {
+        thread_pool pool(t);
+        long f = 0, s = 0;
+        double fib_ms = time_ms([&] { f = fib_par(pool, fib_n); });
+        double sum_ms = time_ms([&] { s = sum_par(pool, data, sum_n); });
+        printf("%7u  %10.2f  %12.2f   (%ld, %ld)\n", t, fib_ms, sum_ms, f, s);
+    }
+    delete[] data;
+}
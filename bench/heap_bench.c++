@@ -0,0 +1,57 @@
+// priority_queue 不同叉数的 push / pop 基准
+// g++ -O2 -std=c++17 -I../include heap_bench.c++ -o heap_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "queue.h"
+#include "random.h"
+using namespace mystl;
+
+template <size_t D>
+static void run(const unsigned* keys, int n) {
+    priority_queue<unsigned, vector<unsigned>, less<unsigned>, D> pq;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) pq.push(keys[i]);
+    auto t1 = std::chrono::steady_clock::now();
+    unsigned long check = 0;
+    while (!pq.empty()) {
+        check += pq.top();
+        pq.pop();
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    printf("%zu-ary  push %8.2f ms  pop %8.2f ms  (%lu)\n", D,
+           std::chrono::duration<double, std::milli>(t1 - t0).count(),
+           std::chrono::duration<double, std::milli>(t2 - t1).count(), check);
+}
+
+// 批量装载：逐个 push 与区间构造 (O(n) 建堆)
+static void bulk_load(const unsigned* keys, int n) {
+    auto t0 = std::chrono::steady_clock::now();
+    priority_queue<unsigned> a;
+    for (int i = 0; i < n; ++i) a.push(keys[i]);
+    auto t1 = std::chrono::steady_clock::now();
+    priority_queue<unsigned> b(keys, keys + n);
+    auto t2 = std::chrono::steady_clock::now();
+    priority_queue<unsigned> c;
+    c.push_range(keys, keys + n / 2);
+    c.push_range(keys + n / 2, keys + n);
+    auto t3 = std::chrono::steady_clock::now();
+    printf("bulk load  push %8.2f ms  range ctor %8.2f ms  push_range x2 %8.2f ms  (%u %u %u)\n",
+           std::chrono::duration<double, std::milli>(t1 - t0).count(),
+           std::chrono::duration<double, std::milli>(t2 - t1).count(),
+           std::chrono::duration<double, std::milli>(t3 - t2).count(), a.top(), b.top(), c.top());
+}
+
+int main(int argc, char** argv) {
+    const int n = argc > 1 ? atoi(argv[1]) : 1 << 21;
+    unsigned* keys = new unsigned[n];
+    xorshift32 rng(12345);
+    for (int i = 0; i < n; ++i) keys[i] = rng();
+
+    printf("%d random keys\n", n);
+    run<2>(keys, n);
+    run<4>(keys, n);
+    run<8>(keys, n);
+    bulk_load(keys, n);
+    delete[] keys;
+}
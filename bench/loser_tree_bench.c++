@@ -0,0 +1,101 @@
+// k 路归并：败者树 multiway_merge 与 priority_queue 的对比，k = 2 .. 1024
+// 同时统计每输出一个元素的平均比较次数
+// g++ -O2 -std=c++17 -I../include loser_tree_bench.c++ -o loser_tree_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include "loser_tree.h"
+#include "queue.h"
+#include "random.h"
+using namespace mystl;
+
+static unsigned long g_cmps = 0;
+
+template <bool Count>
+struct key_less {
+    bool operator() (unsigned a, unsigned b) {
+        if (Count) ++g_cmps;
+        return a < b;
+    }
+};
+
+struct head {
+    unsigned key;
+    unsigned run;
+};
+
+// priority_queue 默认是大顶堆，反过来比较得到最小的 key
+template <bool Count>
+struct head_greater {
+    bool operator() (const head& a, const head& b) {
+        if (Count) ++g_cmps;
+        return b.key < a.key;
+    }
+};
+
+template <bool Count>
+static double merge_loser(pair<unsigned*, unsigned*>* runs, int k, unsigned* out) {
+    auto t0 = std::chrono::steady_clock::now();
+    multiway_merge(runs, runs + k, out, key_less<Count>());
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+template <bool Count>
+static double merge_heap(pair<unsigned*, unsigned*>* runs, int k, unsigned* out) {
+    auto t0 = std::chrono::steady_clock::now();
+    pair<unsigned*, unsigned*>* cur = new pair<unsigned*, unsigned*>[k];
+    priority_queue<head, vector<head>, head_greater<Count>> pq;
+    for (int i = 0; i < k; ++i) {
+        cur[i] = runs[i];
+        if (cur[i].first != cur[i].second) pq.push(head{ *cur[i].first, static_cast<unsigned>(i) });
+    }
+    while (!pq.empty()) {
+        const unsigned r = pq.top().run;
+        *out++ = pq.top().key;
+        pq.pop();
+        if (++cur[r].first != cur[r].second) pq.push(head{ *cur[r].first, r });
+    }
+    delete[] cur;
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+int main(int argc, char** argv) {
+    const int n = argc > 1 ? atoi(argv[1]) : 1 << 22;
+    unsigned* data = new unsigned[n];
+    unsigned* out = new unsigned[n];
+    pair<unsigned*, unsigned*>* runs = new pair<unsigned*, unsigned*>[1024];
+    xorshift32 rng(4242);
+
+    printf("%d keys\n", n);
+    printf("%6s %12s %12s %10s %10s\n", "k", "loser ms", "heap ms", "loser cmp", "heap cmp");
+    for (int k = 2; k <= 1024; k *= 2) {
+        // 长度不等的 k 段，各自排序，让各路在不同时刻耗尽
+        for (int i = 0; i < n; ++i) data[i] = rng();
+        int pos = 0;
+        for (int i = 0; i < k; ++i) {
+            int len = i == k - 1 ? n - pos : static_cast<int>(rng(2 * (n - pos) / (k - i) + 1));
+            std::sort(data + pos, data + pos + len);
+            runs[i] = pair<unsigned*, unsigned*>(data + pos, data + pos + len);
+            pos += len;
+        }
+
+        const double tl = merge_loser<false>(runs, k, out);
+        unsigned long check = out[n / 2];
+        const double th = merge_heap<false>(runs, k, out);
+        if (out[n / 2] != check) printf("mismatch at k = %d\n", k);
+
+        g_cmps = 0;
+        merge_loser<true>(runs, k, out);
+        const double cl = static_cast<double>(g_cmps) / n;
+        g_cmps = 0;
+        merge_heap<true>(runs, k, out);
+        const double ch = static_cast<double>(g_cmps) / n;
+        printf("%6d %12.2f %12.2f %10.2f %10.2f\n", k, tl, th, cl, ch);
+    }
+    delete[] runs;
+    delete[] out;
+    delete[] data;
+}
@@ -0,0 +1,70 @@
+// top-K 流式统计：min-max heap 与两个 priority_queue (大顶 + 小顶，延迟删除) 的对比
+// 每读入一个 key 保留最大的 K 个，并随时查询其中的最小值和最大值
+// g++ -O2 -std=c++17 -I../include minmax_heap_bench.c++ -o minmax_heap_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "minmax_heap.h"
+#include "queue.h"
+#include "random.h"
+using namespace mystl;
+
+static double top_k_minmax(const unsigned* keys, int n, int k, unsigned long& check) {
+    auto t0 = std::chrono::steady_clock::now();
+    minmax_heap<unsigned> h;
+    for (int i = 0; i < n; ++i) {
+        if (static_cast<int>(h.size()) < k) {
+            h.push(keys[i]);
+        }
+        else if (h.min() < keys[i]) {
+            h.replace_min(keys[i]);
+        }
+        check += h.min() + h.max();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// 小顶堆负责淘汰；大顶堆负责查询最大值，被淘汰的元素记在 dead 中，到达堆顶时才真正删除
+static double top_k_two_heaps(const unsigned* keys, int n, int k, unsigned long& check) {
+    auto t0 = std::chrono::steady_clock::now();
+    priority_queue<unsigned, vector<unsigned>, greater<unsigned>> lo;
+    priority_queue<unsigned> hi, dead;
+    for (int i = 0; i < n; ++i) {
+        if (static_cast<int>(lo.size()) < k) {
+            lo.push(keys[i]);
+            hi.push(keys[i]);
+        }
+        else if (lo.top() < keys[i]) {
+            dead.push(lo.top());
+            lo.pop();
+            lo.push(keys[i]);
+            hi.push(keys[i]);
+        }
+        while (!dead.empty() && dead.top() == hi.top()) {
+            dead.pop();
+            hi.pop();
+        }
+        check += lo.top() + hi.top();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+int main(int argc, char** argv) {
+    const int n = argc > 1 ? atoi(argv[1]) : 1 << 22;
+    unsigned* keys = new unsigned[n];
+    xorshift32 rng(777);
+    // 缓慢上升的 key 让 top-K 持续更替
+    for (int i = 0; i < n; ++i) keys[i] = rng(1u << 20) + static_cast<unsigned>(i) * 64;
+
+    printf("%d keys\n", n);
+    printf("%8s %14s %14s\n", "K", "minmax ms", "two heaps ms");
+    for (int k = 16; k <= (1 << 16); k *= 16) {
+        unsigned long c1 = 0, c2 = 0;
+        const double t1 = top_k_minmax(keys, n, k, c1);
+        const double t2 = top_k_two_heaps(keys, n, k, c2);
+        printf("%8d %14.2f %14.2f%s\n", k, t1, t2, c1 == c2 ? "" : "  mismatch");
+    }
+    delete[] keys;
+}
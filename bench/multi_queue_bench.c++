@@ -0,0 +1,103 @@
+// multi_queue 与 mutex + priority_queue 的吞吐量、以及 multi_queue 的排名误差
+// g++ -O2 -std=c++17 -pthread -I../include multi_queue_bench.c++ -o multi_queue_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "multi_queue.h"
+using namespace mystl;
+
+struct locked_queue {
+    std::mutex                                              mtx;
+    priority_queue<unsigned, vector<unsigned>, greater<unsigned>>   q;
+
+    void push(unsigned x) {
+        std::lock_guard<std::mutex> lock(mtx);
+        q.push(x);
+    }
+    bool try_pop(unsigned& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (q.empty()) return false;
+        out = q.top();
+        q.pop();
+        return true;
+    }
+};
+
+typedef multi_queue<unsigned, greater<unsigned>> mq_type;
+
+// 每个线程交替 push / pop
+template <class Q>
+static double throughput(Q& q, unsigned threads, long ops) {
+    for (unsigned i = 0; i < 100000; ++i) q.push(i * 2654435761u);
+    auto start = std::chrono::steady_clock::now();
+    std::thread* ths = new std::thread[threads];
+    for (unsigned t = 0; t < threads; ++t) {
+        ths[t] = std::thread([&q, ops, t] {
+            xorshift32 rng(t + 1);
+            unsigned v;
+            for (long i = 0; i < ops; ++i) {
+                q.push(rng());
+                q.try_pop(v);
+            }
+        });
+    }
+    for (unsigned t = 0; t < threads; ++t) ths[t].join();
+    delete[] ths;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return threads * ops * 2 / ms / 1000.0;   // 百万次操作 / 秒
+}
+
+// 排名误差：预先放入 0..n-1，多线程弹出并记录全局序号，之后按序重放，
+// 用树状数组统计每次弹出时还有多少更小的 key 留在队列里
+static double rank_error(unsigned threads, unsigned n) {
+    mq_type q(threads);
+    // 2654435761 为素数，只要 n 不是它的倍数，i * 2654435761 % n 就是 0..n-1 的一个排列
+    for (unsigned i = 0; i < n; ++i) q.push(static_cast<unsigned>(i * 2654435761ull % n));
+    unsigned* order = new unsigned[n];
+    std::atomic<unsigned> seq(0);
+    std::thread* ths = new std::thread[threads];
+    for (unsigned t = 0; t < threads; ++t) {
+        ths[t] = std::thread([&] {
+            unsigned v;
+            while (q.try_pop(v)) order[seq.fetch_add(1)] = v;
+        });
+    }
+    for (unsigned t = 0; t < threads; ++t) ths[t].join();
+    delete[] ths;
+
+    unsigned* bit = new unsigned[n + 1]();
+    for (unsigned i = 1; i <= n; ++i) {
+        bit[i] += 1;
+        unsigned j = i + (i & -i);
+        if (j <= n) bit[j] += bit[i];
+    }
+    double total = 0;
+    const unsigned popped = seq.load();
+    for (unsigned k = 0; k < popped; ++k) {
+        unsigned key = order[k];
+        unsigned smaller = 0;
+        for (unsigned i = key; i > 0; i -= i & -i) smaller += bit[i];
+        total += smaller;
+        for (unsigned i = key + 1; i <= n; i += i & -i) bit[i] -= 1;
+    }
+    delete[] bit;
+    delete[] order;
+    return total / popped;
+}
+
+int main(int argc, char** argv) {
+    const long ops = argc > 1 ? atol(argv[1]) : 1000000;
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (max_threads < 8) max_threads = 8;
+
+    printf("threads  locked Mops/s  multi_queue Mops/s  mean rank error\n");
+    for (unsigned t = 1; t <= max_threads; t <<= 1) {
+        locked_queue a;
+        mq_type b(t);
+        double ta = throughput(a, t, ops);
+        double tb = throughput(b, t, ops);
+        printf("%7u  %13.2f  %18.2f  %15.2f\n", t, ta, tb, rank_error(t, 1000000));
+    }
+}
@@ -0,0 +1,86 @@
+// 一键多值：multimap 与 map<K, vector<V>> 的插入、按键查询全部值、按键删除的对比
+// g++ -O2 -std=c++17 -I../include multimap_bench.c++ -o multimap_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "map.h"
+#include "vector.h"
+#include "random.h"
+using namespace mystl;
+
+typedef multimap<unsigned, unsigned> mmap;
+typedef map<unsigned, vector<unsigned>> vmap;
+
+static double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void run_multimap(const unsigned* keys, int n, int keyspace, double* t, unsigned long& check) {
+    mmap m;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        m.insert(pair<unsigned, unsigned>(keys[i], i));
+    t[0] = ms_since(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        pair<mmap::iterator, mmap::iterator> r = m.equal_range(keys[i]);
+        for (; r.first != r.second; ++r.first) check += (*r.first).second;
+    }
+    t[1] = ms_since(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < keyspace; k += 2)
+        check += m.erase(static_cast<unsigned>(k));
+    t[2] = ms_since(t0);
+}
+
+static void run_vector_map(const unsigned* keys, int n, int keyspace, double* t, unsigned long& check) {
+    vmap m;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        vmap::iterator it = m.find(keys[i]);
+        if (it == m.end())
+            it = m.insert(pair<unsigned, vector<unsigned>>(keys[i], vector<unsigned>())).first;
+        (*it).second.push_back(i);
+    }
+    t[0] = ms_since(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        vmap::iterator it = m.find(keys[i]);
+        if (it == m.end()) continue;
+        vector<unsigned>& v = (*it).second;
+        for (unsigned* p = v.begin(); p != v.end(); ++p) check += *p;
+    }
+    t[1] = ms_since(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < keyspace; k += 2) {
+        vmap::iterator it = m.find(static_cast<unsigned>(k));
+        if (it == m.end()) continue;
+        check += (*it).second.size();
+        m.erase(it);
+    }
+    t[2] = ms_since(t0);
+}
+
+int main(int argc, char** argv) {
+    const int n = argc > 1 ? atoi(argv[1]) : 1 << 20;
+    unsigned* keys = new unsigned[n];
+    xorshift32 rng(31);
+
+    printf("%d values\n", n);
+    printf("%10s %24s %24s %24s\n", "per key", "insert ms (mm / m<v>)", "query ms (mm / m<v>)", "erase ms (mm / m<v>)");
+    for (int per_key = 1; per_key <= 64; per_key *= 4) {
+        const int keyspace = n / per_key;
+        for (int i = 0; i < n; ++i) keys[i] = rng(static_cast<unsigned>(keyspace));
+        double a[3], b[3];
+        unsigned long c1 = 0, c2 = 0;
+        run_multimap(keys, n, keyspace, a, c1);
+        run_vector_map(keys, n, keyspace, b, c2);
+        printf("%10d %11.2f / %10.2f %11.2f / %10.2f %11.2f / %10.2f%s\n",
+               per_key, a[0], b[0], a[1], b[1], a[2], b[2], c1 == c2 ? "" : "  mismatch");
+    }
+    delete[] keys;
+}
@@ -0,0 +1,62 @@
+// set 的并行批量建树与并行并集，按线程数 1, 2, 4 ... hardware_concurrency 测伸缩性
+// 第一行 (seq) 是单线程的 insert(first, last) 与 set_union，作为基准
+// 默认 n = 4M，原始需求的规模可以传 100000000 (两个输入加上两棵树约需 10GB 内存)
+// g++ -O2 -std=c++17 -pthread -I../include parallel_set_bench.c++ -o parallel_set_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "set.h"
+#include "thread_pool.h"
+#include "random.h"
+#include "bench_threads.h"
+using namespace mystl;
+
+typedef set<unsigned> uset;
+
+static double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    const int n = argc > 1 ? atoi(argv[1]) : 1 << 22;
+    const unsigned max_threads = max_bench_threads();
+    unsigned* a = new unsigned[n];
+    unsigned* b = new unsigned[n];
+    xorshift32 rng(50);
+    // 键空间为 4n，两个集合有一部分重叠
+    for (int i = 0; i < n; ++i) a[i] = rng(4u * n);
+    for (int i = 0; i < n; ++i) b[i] = rng(4u * n);
+
+    size_t build_size, union_size;
+    double build_seq, union_seq;
+    {
+        uset x, y;
+        auto t0 = std::chrono::steady_clock::now();
+        x.insert(a, a + n);
+        build_seq = ms_since(t0), build_size = x.size();
+        y.insert(b, b + n);
+        t0 = std::chrono::steady_clock::now();
+        x.set_union(y);
+        union_seq = ms_since(t0), union_size = x.size();
+    }
+
+    printf("n = %d, %u hardware threads\n", n, max_threads);
+    printf("threads    build ms  speedup    union ms  speedup\n");
+    printf("%7s  %10.2f  %7.2f  %10.2f  %7.2f\n", "seq", build_seq, 1.0, union_seq, 1.0);
+    for (unsigned t = 1; t <= max_threads; t = next_thread_count(t, max_threads)) {
+        thread_pool pool(t);
+        uset x, y;
+        auto t0 = std::chrono::steady_clock::now();
+        x.parallel_insert(a, a + n, pool);
+        const double build_ms = ms_since(t0);
+        const bool build_ok = x.size() == build_size;
+        y.parallel_insert(b, b + n, pool);
+        t0 = std::chrono::steady_clock::now();
+        x.parallel_set_union(y, pool);
+        const double union_ms = ms_since(t0);
+        printf("%7u  %10.2f  %7.2f  %10.2f  %7.2f%s\n", t, build_ms, build_seq / build_ms,
+               union_ms, union_seq / union_ms, build_ok && x.size() == union_size ? "" : "  mismatch");
+    }
+    delete[] b;
+    delete[] a;
+}
@@ -0,0 +1,45 @@
+// radix_heap 与 heap.h 上的 priority_queue 在单调 (Dijkstra / 定时器式) 负载下的对比
+// g++ -O2 -std=c++17 -I../include radix_heap_bench.c++ -o radix_heap_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "queue.h"
+#include "radix_heap.h"
+#include "random.h"
+using namespace mystl;
+
+// 每次弹出最小值 m，再压入若干个 m + 随机增量，队列规模保持在 live 附近
+template <class Heap>
+static double run(Heap& h, int live, int ops, unsigned long& check) {
+    xorshift32 rng(7);
+    for (int i = 0; i < live; ++i) h.push(rng() % 100000);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ops; ++i) {
+        unsigned m = h.top();
+        h.pop();
+        check += m;
+        h.push(m + 1 + rng() % 1000);
+    }
+    while (!h.empty()) {
+        check += h.top();
+        h.pop();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    const int ops = argc > 1 ? atoi(argv[1]) : 4000000;
+    int sizes[] = { 1000, 100000, 1000000 };
+    printf("live      binary-heap ms  4-ary ms  radix ms\n");
+    for (int live : sizes) {
+        unsigned long c1 = 0, c2 = 0, c3 = 0;
+        priority_queue<unsigned, vector<unsigned>, greater<unsigned>, 2> b;
+        priority_queue<unsigned, vector<unsigned>, greater<unsigned>, 4> q;
+        radix_heap<unsigned> r;
+        double tb = run(b, live, ops, c1);
+        double tq = run(q, live, ops, c2);
+        double tr = run(r, live, ops, c3);
+        printf("%-8d  %14.2f  %8.2f  %8.2f   %s\n", live, tb, tq, tr,
+               c1 == c2 && c2 == c3 ? "" : "MISMATCH");
+    }
+}
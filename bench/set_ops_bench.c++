@@ -0,0 +1,83 @@
+// 两个 set 的并集：基于 join 的 set_union 与逐个插入、区间插入的对比，另测交集和差集
+// 每组先用同样的数据建好两个 set，只计合并本身的时间
+// 交集和差集要释放结果中不再需要的节点，|y| 很小时交集的时间主要花在释放 x 的节点上
+// g++ -O2 -std=c++17 -I../include set_ops_bench.c++ -o set_ops_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "set.h"
+#include "random.h"
+using namespace mystl;
+
+typedef set<unsigned> uset;
+
+static double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void fill(uset& s, const unsigned* keys, int n) {
+    for (int i = 0; i < n; ++i) s.insert(keys[i]);
+}
+
+static void run(const unsigned* a, int n, const unsigned* b, int m) {
+    double t[5];
+    size_t size[5], nx;
+    {
+        uset x;
+        fill(x, a, n);
+        nx = x.size();
+    }
+    {
+        uset x, y;
+        fill(x, a, n), fill(y, b, m);
+        auto t0 = std::chrono::steady_clock::now();
+        for (uset::iterator it = y.begin(); it != y.end(); ++it) x.insert(*it);
+        t[0] = ms_since(t0), size[0] = x.size();
+    }
+    {
+        uset x, y;
+        fill(x, a, n), fill(y, b, m);
+        auto t0 = std::chrono::steady_clock::now();
+        x.insert(y.begin(), y.end());
+        t[1] = ms_since(t0), size[1] = x.size();
+    }
+    {
+        uset x, y;
+        fill(x, a, n), fill(y, b, m);
+        auto t0 = std::chrono::steady_clock::now();
+        x.set_union(y);
+        t[2] = ms_since(t0), size[2] = x.size();
+    }
+    {
+        uset x, y;
+        fill(x, a, n), fill(y, b, m);
+        auto t0 = std::chrono::steady_clock::now();
+        x.set_intersection(y);
+        t[3] = ms_since(t0), size[3] = x.size();
+    }
+    {
+        uset x, y;
+        fill(x, a, n), fill(y, b, m);
+        auto t0 = std::chrono::steady_clock::now();
+        x.set_difference(y);
+        t[4] = ms_since(t0), size[4] = x.size();
+    }
+    printf("%9d %9d %11.2f %11.2f %11.2f %11.2f %11.2f%s\n", n, m, t[0], t[1], t[2], t[3], t[4],
+           size[0] == size[1] && size[1] == size[2] && size[3] + size[4] == nx ? "" : "  mismatch");
+}
+
+int main(int argc, char** argv) {
+    const int n = argc > 1 ? atoi(argv[1]) : 1 << 20;
+    unsigned* a = new unsigned[n];
+    unsigned* b = new unsigned[n];
+    xorshift32 rng(8);
+    // 键空间为 4n，两个集合有一部分重叠
+    for (int i = 0; i < n; ++i) a[i] = rng(4u * n);
+    for (int i = 0; i < n; ++i) b[i] = rng(4u * n);
+
+    printf("%9s %9s %11s %11s %11s %11s %11s\n", "|x|", "|y|", "insert ms", "range ms", "union ms", "inter ms", "diff ms");
+    for (int m = n; m >= 16; m /= 16)
+        run(a, n, b, m);
+    delete[] b;
+    delete[] a;
+}
@@ -0,0 +1,62 @@
+// unrolled_list 与 mystl::list / mystl::vector 的遍历与中部插入基准
+// g++ -O2 -std=c++17 -I../include unrolled_list_bench.c++ -o unrolled_list_bench
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "list.h"
+#include "vector.h"
+#include "unrolled_list.h"
+using namespace mystl;
+
+template <class F>
+static double time_ms(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class Seq>
+static long traverse(Seq& s) {
+    long sum = 0;
+    for (auto it = s.begin(); it != s.end(); ++it) sum += *it;
+    return sum;
+}
+
+// 走到中点再插入，list 类容器都需要线性定位
+template <class Seq>
+static void mid_insert(Seq& s, int count) {
+    for (int i = 0; i < count; ++i) {
+        auto it = s.begin();
+        for (size_t k = s.size() / 2; k > 0; --k) ++it;
+        s.insert(it, i);
+    }
+}
+
+int main(int argc, char** argv) {
+    const int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    const int inserts = argc > 2 ? atoi(argv[2]) : 2000;
+
+    list<int> l;
+    vector<int> v;
+    unrolled_list<int> u;
+    for (int i = 0; i < n; ++i) {
+        l.push_back(i);
+        v.push_back(i);
+        u.push_back(i);
+    }
+
+    long s1 = 0, s2 = 0, s3 = 0;
+    double tl = time_ms([&] { for (int r = 0; r < 10; ++r) s1 += traverse(l); });
+    double tv = time_ms([&] { for (int r = 0; r < 10; ++r) s2 += traverse(v); });
+    double tu = time_ms([&] { for (int r = 0; r < 10; ++r) s3 += traverse(u); });
+    printf("traverse x10 (%d elems)  list %.2f ms  vector %.2f ms  unrolled %.2f ms  (%ld %ld %ld)\n",
+           n, tl, tv, tu, s1, s2, s3);
+
+    tl = time_ms([&] { mid_insert(l, inserts); });
+    tv = time_ms([&] {
+        for (int i = 0; i < inserts; ++i) v.insert(v.begin() + v.size() / 2, 1, i);
+    });
+    tu = time_ms([&] { mid_insert(u, inserts); });
+    printf("mid insert x%d          list %.2f ms  vector %.2f ms  unrolled %.2f ms\n",
+           inserts, tl, tv, tu);
+}
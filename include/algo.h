@@ -1,5 +1,10 @@
 #ifndef ALGO_H
 #define ALGO_H
+#include "iterator.h"
+#include "functional.h"
+#include "util.h"
+#include "allocator.h"
+#include "construct.h"
 namespace mystl {
 
 template <class T>
@@ -18,9 +23,193 @@ const T& max(const T& lhs, const T& rhs, Compare comp)
 
 template <class T>
 void swap(T& lhs, T& rhs) {
-  T temp = rhs;
-  lhs = temp;
-  rhs = lhs;
+  T temp = mystl::move(lhs);
+  lhs = mystl::move(rhs);
+  rhs = mystl::move(temp);
+}
+
+
+// sort：内省排序，快速排序递归过深时改用堆排序，小区间最后统一插入排序
+// 不稳定，最坏 O(n log n)
+
+// 小于该长度的区间留给插入排序
+static constexpr ptrdiff_t sort_threshold = 16;
+
+template <class RandomIter, class Compare>
+void __insertion_sort(RandomIter first, RandomIter last, Compare& comp)
+{
+  if (first == last) return;
+  for (RandomIter i = first + 1; i != last; ++i)
+  {
+    typename iterator_traits<RandomIter>::value_type value = mystl::move(*i);
+    RandomIter j = i;
+    if (comp(value, *first))
+    { // 比第一个还小，整段后移
+      for (; j != first; --j)
+        *j = mystl::move(*(j - 1));
+    }
+    else
+    { // 此时 *first 是哨兵，不必检查越界
+      for (; comp(value, *(j - 1)); --j)
+        *j = mystl::move(*(j - 1));
+    }
+    *j = mystl::move(value);
+  }
+}
+
+// 大顶堆下沉，供堆排序使用
+template <class RandomIter, class Distance, class T, class Compare>
+void __sort_sift_down(RandomIter first, Distance hole, Distance len, T value, Compare& comp)
+{
+  while (true)
+  {
+    Distance child = 2 * hole + 1;
+    if (child >= len) break;
+    if (child + 1 < len && comp(*(first + child), *(first + child + 1))) ++child;
+    if (!comp(value, *(first + child))) break;
+    *(first + hole) = mystl::move(*(first + child));
+    hole = child;
+  }
+  *(first + hole) = mystl::move(value);
+}
+
+template <class RandomIter, class Compare>
+void __heap_sort(RandomIter first, RandomIter last, Compare& comp)
+{
+  typedef typename iterator_traits<RandomIter>::difference_type Distance;
+  typedef typename iterator_traits<RandomIter>::value_type      T;
+  Distance len = last - first;
+  for (Distance hole = len / 2 - 1; hole >= 0; --hole)
+  {
+    T value = mystl::move(*(first + hole));
+    __sort_sift_down(first, hole, len, mystl::move(value), comp);
+  }
+  while (len > 1)
+  {
+    --len;
+    T value = mystl::move(*(first + len));
+    *(first + len) = mystl::move(*first);
+    __sort_sift_down(first, Distance(0), len, mystl::move(value), comp);
+  }
+}
+
+// 三数取中放到 first 处作为枢轴
+template <class RandomIter, class Compare>
+void __median_to_first(RandomIter first, RandomIter a, RandomIter b, RandomIter c, Compare& comp)
+{
+  if (comp(*a, *b))
+  {
+    if (comp(*b, *c))      mystl::swap(*first, *b);
+    else if (comp(*a, *c)) mystl::swap(*first, *c);
+    else                   mystl::swap(*first, *a);
+  }
+  else if (comp(*a, *c))   mystl::swap(*first, *a);
+  else if (comp(*b, *c))   mystl::swap(*first, *c);
+  else                     mystl::swap(*first, *b);
+}
+
+template <class RandomIter, class Compare>
+void __introsort_loop(RandomIter first, RandomIter last, int depth_limit, Compare& comp)
+{
+  while (last - first > sort_threshold)
+  {
+    if (depth_limit == 0)
+    {
+      __heap_sort(first, last, comp);
+      return;
+    }
+    --depth_limit;
+    RandomIter mid = first + (last - first) / 2;
+    __median_to_first(first, first + 1, mid, last - 1, comp);
+    // Hoare 划分，*first 为枢轴，两端都有不小于 / 不大于枢轴的哨兵
+    RandomIter lo = first + 1, hi = last;
+    while (true)
+    {
+      while (comp(*lo, *first)) ++lo;
+      --hi;
+      while (comp(*first, *hi)) --hi;
+      if (!(lo < hi)) break;
+      mystl::swap(*lo, *hi);
+      ++lo;
+    }
+    // 递归处理右半段，循环处理左半段
+    __introsort_loop(lo, last, depth_limit, comp);
+    last = lo;
+  }
+}
+
+template <class RandomIter, class Compare>
+void sort(RandomIter first, RandomIter last, Compare comp)
+{
+  if (last - first < 2) return;
+  int depth_limit = 0;
+  for (ptrdiff_t n = last - first; n > 1; n >>= 1)
+    depth_limit += 2;
+  __introsort_loop(first, last, depth_limit, comp);
+  __insertion_sort(first, last, comp);
+}
+
+template <class RandomIter>
+void sort(RandomIter first, RandomIter last)
+{
+  mystl::sort(first, last, mystl::less<typename iterator_traits<RandomIter>::value_type>());
+}
+
+
+// stable_sort：自底向上归并排序，先对每 sort_threshold 个元素做插入排序，
+// 再在原区间与缓冲区之间来回归并；稳定，O(n log n)，额外空间 n 个元素
+
+// 把 src 中相邻的两段 [lo, mid) 和 [mid, hi) 归并到 dst，键相等时先取左段
+template <class Iter1, class Iter2, class Compare>
+void __merge_pass(Iter1 src, ptrdiff_t n, ptrdiff_t width, Iter2 dst, Compare& comp)
+{
+  for (ptrdiff_t lo = 0; lo < n; lo += width * 2)
+  {
+    const ptrdiff_t mid = lo + width < n ? lo + width : n;
+    const ptrdiff_t hi = mid + width < n ? mid + width : n;
+    ptrdiff_t i = lo, j = mid, k = lo;
+    while (i < mid && j < hi)
+    {
+      if (comp(src[j], src[i])) dst[k++] = mystl::move(src[j++]);
+      else                      dst[k++] = mystl::move(src[i++]);
+    }
+    while (i < mid) dst[k++] = mystl::move(src[i++]);
+    while (j < hi)  dst[k++] = mystl::move(src[j++]);
+  }
+}
+
+template <class RandomIter, class Compare>
+void stable_sort(RandomIter first, RandomIter last, Compare comp)
+{
+  typedef typename iterator_traits<RandomIter>::value_type value_type;
+  const ptrdiff_t n = last - first;
+  for (ptrdiff_t i = 0; i < n; i += sort_threshold)
+    __insertion_sort(first + i, n - i < sort_threshold ? last : first + i + sort_threshold, comp);
+  if (n <= sort_threshold) return;
+
+  value_type* buf = alloc<value_type>::allocate(n);
+  for (ptrdiff_t i = 0; i < n; ++i)
+    mystl::construct(buf + i, mystl::move(first[i]));
+  // 数据在 buf 与原区间之间交替，in_buf 记录当前在哪一边
+  bool in_buf = true;
+  for (ptrdiff_t width = sort_threshold; width < n; width *= 2, in_buf = !in_buf)
+  {
+    if (in_buf) __merge_pass(buf, n, width, first, comp);
+    else        __merge_pass(first, n, width, buf, comp);
+  }
+  if (in_buf)
+  {
+    for (ptrdiff_t i = 0; i < n; ++i)
+      first[i] = mystl::move(buf[i]);
+  }
+  mystl::destory(buf, buf + n);
+  alloc<value_type>::deallocate(buf, n);
+}
+
+template <class RandomIter>
+void stable_sort(RandomIter first, RandomIter last)
+{
+  mystl::stable_sort(first, last, mystl::less<typename iterator_traits<RandomIter>::value_type>());
 }
 
 
@@ -26,19 +26,13 @@ private:
 template<class T>
 T* alloc<T>::allocate(size_t n) {
     if (n == 0)  return nullptr;
-    size_t _size = (sizeof T()) * n;
-    if (sizeof T() < 1024) {
-        return static_cast<T*>(::operator new(_size));
-    }
+    return static_cast<T*>(::operator new(sizeof(T) * n));
 }
 
 // deallocate
 template<class T>
 void alloc<T>::deallocate(T* ptr, size_t n) {
     if (n == 0)  return;
-    size_t _size = (sizeof T()) * n;
-    if (sizeof T() < 1024) {
-    }
     ::operator delete(ptr);
 }
 
@@ -0,0 +1,594 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include <new>
+#include <assert.h>
+#include "allocator.h"
+#include "construct.h"
+#include "iterator.h"
+#include "functional.h"
+#include "pair.h"
+#include "util.h"
+
+namespace mystl {
+
+// B+ 树节点
+// 元素只存放在叶子中，叶子之间双向链接用于顺序遍历；内部节点只存分隔键和孩子指针
+// 内部节点中 keys[i] 大于 children[i] 中所有键，且不大于 children[i + 1] 中所有键
+
+struct __btree_node_base {
+    bool            leaf;
+    unsigned short  count;  // 叶子为元素个数，内部节点为键的个数
+};
+
+template <class Value, size_t L>
+struct __btree_leaf : public __btree_node_base {
+    __btree_leaf*   prev;
+    __btree_leaf*   next;
+    Value           values[L];
+};
+
+template <class Key, size_t I>
+struct __btree_inner : public __btree_node_base {
+    Key                  keys[I];
+    __btree_node_base*   children[I + 1];
+};
+
+// 由节点字节数计算容量，至少为 4
+template <class Value, size_t NodeBytes>
+struct btree_leaf_capacity {
+    static constexpr size_t header = sizeof(__btree_node_base) + 2 * sizeof(void*);
+    static constexpr size_t fit = NodeBytes > header ? (NodeBytes - header) / sizeof(Value) : 0;
+    static constexpr size_t value = fit < 4 ? 4 : fit;
+};
+
+template <class Key, size_t NodeBytes>
+struct btree_inner_capacity {
+    static constexpr size_t header = sizeof(__btree_node_base) + sizeof(void*);
+    static constexpr size_t fit = NodeBytes > header ? (NodeBytes - header) / (sizeof(Key) + sizeof(void*)) : 0;
+    static constexpr size_t value = fit < 4 ? 4 : fit;
+};
+
+
+// 迭代器：叶子指针 + 叶内下标，end() 为 (最右叶子, count)
+template <class Value, size_t L>
+struct btree_iterator : public iterator<bidirectional_iterator_tag, Value> {
+    typedef __btree_leaf<Value, L>*             leaf_ptr;
+    typedef btree_iterator                      self;
+
+    typedef typename self::iterator_category            iterator_category;
+    typedef typename self::value_type                   value_type;
+    typedef typename self::pointer                      pointer;
+    typedef typename self::reference                    reference;
+    typedef typename self::const_reference              const_reference;
+    typedef typename self::difference_type              difference_type;
+
+    leaf_ptr node;
+    size_t   idx;
+
+    btree_iterator() : node(nullptr), idx(0) {}
+    btree_iterator(leaf_ptr n, size_t i) : node(n), idx(i) {}
+    btree_iterator(const btree_iterator& rhs) : node(rhs.node), idx(rhs.idx) {}
+    btree_iterator& operator= (const btree_iterator& rhs) {
+        node = rhs.node;
+        idx = rhs.idx;
+        return *this;
+    }
+
+    bool operator== (const self& rhs) const { return node == rhs.node && idx == rhs.idx; }
+    bool operator!= (const self& rhs) const { return !(*this == rhs); }
+
+    reference operator* () const { return node->values[idx]; }
+    pointer operator-> () const { return &operator*(); }
+
+    self& operator++ () {
+        if (++idx == node->count && node->next != nullptr) {
+            node = node->next;
+            idx = 0;
+        }
+        return *this;
+    }
+    self operator++ (int) {
+        self temp = *this;
+        ++*this;
+        return temp;
+    }
+    self& operator-- () {
+        if (idx == 0) {
+            node = node->prev;
+            idx = node->count;
+        }
+        --idx;
+        return *this;
+    }
+    self operator-- (int) {
+        self temp = *this;
+        --*this;
+        return temp;
+    }
+};
+
+
+// B+ 树，接口与 rb_tree 一致 (键唯一)
+// 每个节点约 NodeBytes 字节，一个节点容纳几十个元素，查找只访问 O(log_B n) 个节点，
+// 节点内二分查找落在连续内存上；插入删除会移动叶内元素，所有迭代器随之失效
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes = 256>
+class btree {
+public:
+    typedef Key                                     key_type;
+    typedef Value                                   value_type;
+    typedef Compare                                 key_compare;
+    typedef Value&                                  reference;
+    typedef const Value&                            const_reference;
+    typedef size_t                                  size_type;
+    typedef ptrdiff_t                               difference_type;
+
+    static constexpr size_type leaf_capacity  = btree_leaf_capacity<Value, NodeBytes>::value;
+    static constexpr size_type inner_capacity = btree_inner_capacity<Key, NodeBytes>::value;
+    static constexpr size_type leaf_min       = leaf_capacity / 2;
+    static constexpr size_type inner_min      = inner_capacity / 2;
+
+    static_assert(leaf_capacity < 65536 && inner_capacity < 65536, "btree node too large");
+
+    typedef btree_iterator<Value, leaf_capacity>        iterator;
+
+private:
+    typedef __btree_node_base*                          base_ptr;
+    typedef __btree_leaf<Value, leaf_capacity>          leaf_type;
+    typedef __btree_inner<Key, inner_capacity>          inner_type;
+    typedef leaf_type*                                  leaf_ptr;
+    typedef inner_type*                                 inner_ptr;
+    typedef mystl::alloc<leaf_type>                     leaf_allocator;
+    typedef mystl::alloc<inner_type>                    inner_allocator;
+
+    // 根到叶子的路径：path[d] 为第 d 层内部节点，slot[d] 为下一层所在的孩子下标
+    static constexpr int max_height = 64;
+    struct search_path {
+        inner_ptr   path[max_height];
+        size_type   slot[max_height];
+        int         depth;
+    };
+
+public:
+    btree() : m_size(0), m_leaves(0), m_inners(0) { init(); }
+    ~btree() {
+        destroy_subtree(m_root);
+    }
+    btree(const btree&) = delete;
+    btree& operator= (const btree&) = delete;
+
+    iterator begin() { return iterator(m_first, 0); }
+    iterator end() { return iterator(m_last, m_last->count); }
+    size_type size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    // 节点占用的总字节数
+    size_type memory_usage() const {
+        return sizeof(*this) + m_leaves * sizeof(leaf_type) + m_inners * sizeof(inner_type);
+    }
+
+    pair<iterator, bool> insert_unique(const value_type& v);
+    iterator erase(iterator it);
+    size_type erase(const key_type& k);
+    void clear() {
+        destroy_subtree(m_root);
+        init();
+    }
+
+    iterator find(const key_type& k);
+    // 第一个键不小于 k 的元素
+    iterator lower_bound(const key_type& k);
+
+private:
+    const key_type& key(const value_type& v) const { return KeyOfValue()(v); }
+
+    void init() {
+        leaf_ptr l = create_leaf();
+        m_root = l;
+        m_first = m_last = l;
+        m_size = 0;
+    }
+
+    leaf_ptr create_leaf() {
+        leaf_ptr n = leaf_allocator::allocate();
+        new (n) leaf_type;
+        n->leaf = true;
+        n->count = 0;
+        n->prev = n->next = nullptr;
+        ++m_leaves;
+        return n;
+    }
+    inner_ptr create_inner() {
+        inner_ptr n = inner_allocator::allocate();
+        new (n) inner_type;
+        n->leaf = false;
+        n->count = 0;
+        ++m_inners;
+        return n;
+    }
+    void destroy_leaf(leaf_ptr n) {
+        destory(n);
+        leaf_allocator::deallocate(n);
+        --m_leaves;
+    }
+    void destroy_inner(inner_ptr n) {
+        destory(n);
+        inner_allocator::deallocate(n);
+        --m_inners;
+    }
+    // 递归深度等于树高，很小
+    void destroy_subtree(base_ptr x);
+
+    // 叶内第一个键不小于 k 的下标
+    size_type leaf_lower_bound(leaf_ptr l, const key_type& k);
+    // 内部节点中应进入的孩子下标：键不大于 k 的分隔键个数
+    size_type inner_upper_bound(inner_ptr n, const key_type& k);
+    // 从根下降到 k 所在的叶子，沿途记录路径
+    leaf_ptr descend(const key_type& k, search_path& sp);
+
+    static void leaf_insert_at(leaf_ptr l, size_type pos, const value_type& v);
+    static void inner_insert_at(inner_ptr n, size_type i, const key_type& k, base_ptr child);
+    // 删除 keys[i] 与 children[i + 1]
+    static void inner_remove_at(inner_ptr n, size_type i);
+
+    // 分裂后把 (分隔键, 右节点) 逐层插入父节点，必要时继续分裂，根分裂时树长高一层
+    void insert_into_parent(search_path& sp, key_type sep, base_ptr right);
+    // 删除叶内 pos 处的元素，下溢时向兄弟借或与兄弟合并
+    void erase_at(leaf_ptr l, size_type pos, search_path& sp);
+    void fix_leaf_underflow(leaf_ptr l, search_path& sp);
+    void fix_inner_underflow(search_path& sp, int level);
+
+private:
+    base_ptr    m_root;
+    leaf_ptr    m_first;    // 最左叶子
+    leaf_ptr    m_last;     // 最右叶子
+    size_type   m_size;
+    size_type   m_leaves;
+    size_type   m_inners;
+    key_compare comp;
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::destroy_subtree(base_ptr x) {
+    if (x->leaf) {
+        destroy_leaf(static_cast<leaf_ptr>(x));
+        return;
+    }
+    inner_ptr n = static_cast<inner_ptr>(x);
+    for (size_type i = 0; i <= n->count; ++i)
+        destroy_subtree(n->children[i]);
+    destroy_inner(n);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+typename btree<Key, Value, KeyOfValue, Compare, NodeBytes>::size_type
+btree<Key, Value, KeyOfValue, Compare, NodeBytes>::leaf_lower_bound(leaf_ptr l, const key_type& k) {
+    size_type lo = 0, hi = l->count;
+    while (lo < hi) {
+        size_type mid = (lo + hi) / 2;
+        if (comp(key(l->values[mid]), k)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+typename btree<Key, Value, KeyOfValue, Compare, NodeBytes>::size_type
+btree<Key, Value, KeyOfValue, Compare, NodeBytes>::inner_upper_bound(inner_ptr n, const key_type& k) {
+    size_type lo = 0, hi = n->count;
+    while (lo < hi) {
+        size_type mid = (lo + hi) / 2;
+        if (comp(k, n->keys[mid])) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+typename btree<Key, Value, KeyOfValue, Compare, NodeBytes>::leaf_ptr
+btree<Key, Value, KeyOfValue, Compare, NodeBytes>::descend(const key_type& k, search_path& sp) {
+    base_ptr x = m_root;
+    sp.depth = 0;
+    while (!x->leaf) {
+        inner_ptr n = static_cast<inner_ptr>(x);
+        size_type i = inner_upper_bound(n, k);
+        sp.path[sp.depth] = n;
+        sp.slot[sp.depth] = i;
+        ++sp.depth;
+        x = n->children[i];
+    }
+    return static_cast<leaf_ptr>(x);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+typename btree<Key, Value, KeyOfValue, Compare, NodeBytes>::iterator
+btree<Key, Value, KeyOfValue, Compare, NodeBytes>::lower_bound(const key_type& k) {
+    search_path sp;
+    leaf_ptr l = descend(k, sp);
+    size_type pos = leaf_lower_bound(l, k);
+    // 叶内没有不小于 k 的元素时，答案是下一个叶子的第一个元素
+    if (pos == l->count && l->next != nullptr)
+        return iterator(l->next, 0);
+    return iterator(l, pos);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+typename btree<Key, Value, KeyOfValue, Compare, NodeBytes>::iterator
+btree<Key, Value, KeyOfValue, Compare, NodeBytes>::find(const key_type& k) {
+    search_path sp;
+    leaf_ptr l = descend(k, sp);
+    size_type pos = leaf_lower_bound(l, k);
+    if (pos == l->count || comp(k, key(l->values[pos])))
+        return end();
+    return iterator(l, pos);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::
+leaf_insert_at(leaf_ptr l, size_type pos, const value_type& v) {
+    for (size_type i = l->count; i > pos; --i)
+        l->values[i] = mystl::move(l->values[i - 1]);
+    l->values[pos] = v;
+    ++l->count;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::
+inner_insert_at(inner_ptr n, size_type i, const key_type& k, base_ptr child) {
+    for (size_type j = n->count; j > i; --j) {
+        n->keys[j] = mystl::move(n->keys[j - 1]);
+        n->children[j + 1] = n->children[j];
+    }
+    n->keys[i] = k;
+    n->children[i + 1] = child;
+    ++n->count;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::inner_remove_at(inner_ptr n, size_type i) {
+    for (size_type j = i; j + 1 < n->count; ++j) {
+        n->keys[j] = mystl::move(n->keys[j + 1]);
+        n->children[j + 1] = n->children[j + 2];
+    }
+    --n->count;
+    n->keys[n->count] = key_type();
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+pair<typename btree<Key, Value, KeyOfValue, Compare, NodeBytes>::iterator, bool>
+btree<Key, Value, KeyOfValue, Compare, NodeBytes>::insert_unique(const value_type& v) {
+    const key_type& k = key(v);
+    search_path sp;
+    leaf_ptr l = descend(k, sp);
+    size_type pos = leaf_lower_bound(l, k);
+    if (pos < l->count && !comp(k, key(l->values[pos])))
+        return pair<iterator, bool>(iterator(l, pos), false);
+
+    ++m_size;
+    if (l->count < leaf_capacity) {
+        leaf_insert_at(l, pos, v);
+        return pair<iterator, bool>(iterator(l, pos), true);
+    }
+
+    // 叶子已满：后一半移到新叶子，新叶子链在 l 之后
+    leaf_ptr r = create_leaf();
+    const size_type half = leaf_capacity / 2;
+    for (size_type i = half; i < leaf_capacity; ++i) {
+        r->values[i - half] = mystl::move(l->values[i]);
+        l->values[i] = value_type();
+    }
+    r->count = static_cast<unsigned short>(leaf_capacity - half);
+    l->count = static_cast<unsigned short>(half);
+    r->prev = l;
+    r->next = l->next;
+    if (l->next) l->next->prev = r;
+    else m_last = r;
+    l->next = r;
+
+    leaf_ptr target = l;
+    if (pos > half) {
+        target = r;
+        pos -= half;
+    }
+    leaf_insert_at(target, pos, v);
+    insert_into_parent(sp, key(r->values[0]), r);
+    return pair<iterator, bool>(iterator(target, pos), true);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::
+insert_into_parent(search_path& sp, key_type sep, base_ptr right) {
+    int d = sp.depth;
+    while (true) {
+        if (d == 0) {
+            // 根分裂，树长高一层
+            assert(sp.depth + 1 < max_height);
+            inner_ptr root = create_inner();
+            root->keys[0] = mystl::move(sep);
+            root->children[0] = m_root;
+            root->children[1] = right;
+            root->count = 1;
+            m_root = root;
+            return;
+        }
+        --d;
+        inner_ptr p = sp.path[d];
+        const size_type i = sp.slot[d];
+        if (p->count < inner_capacity) {
+            inner_insert_at(p, i, sep, right);
+            return;
+        }
+        // 内部节点已满：keys[mid] 上移，其后的键和孩子移到新节点 q
+        inner_ptr q = create_inner();
+        const size_type mid = inner_capacity / 2;
+        key_type up = mystl::move(p->keys[mid]);
+        for (size_type j = mid + 1; j < inner_capacity; ++j) {
+            q->keys[j - mid - 1] = mystl::move(p->keys[j]);
+            q->children[j - mid - 1] = p->children[j];
+        }
+        q->children[inner_capacity - mid - 1] = p->children[inner_capacity];
+        q->count = static_cast<unsigned short>(inner_capacity - mid - 1);
+        p->count = static_cast<unsigned short>(mid);
+        for (size_type j = mid; j < inner_capacity; ++j)
+            p->keys[j] = key_type();
+
+        if (i <= mid)
+            inner_insert_at(p, i, sep, right);
+        else
+            inner_insert_at(q, i - mid - 1, sep, right);
+        sep = mystl::move(up);
+        right = q;
+    }
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+typename btree<Key, Value, KeyOfValue, Compare, NodeBytes>::size_type
+btree<Key, Value, KeyOfValue, Compare, NodeBytes>::erase(const key_type& k) {
+    search_path sp;
+    leaf_ptr l = descend(k, sp);
+    size_type pos = leaf_lower_bound(l, k);
+    if (pos == l->count || comp(k, key(l->values[pos])))
+        return 0;
+    erase_at(l, pos, sp);
+    return 1;
+}
+
+// 删除后叶子可能被合并，按原键重新定位后继
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+typename btree<Key, Value, KeyOfValue, Compare, NodeBytes>::iterator
+btree<Key, Value, KeyOfValue, Compare, NodeBytes>::erase(iterator it) {
+    key_type k = key(*it);
+    search_path sp;
+    leaf_ptr l = descend(k, sp);
+    assert(l == it.node);
+    erase_at(l, it.idx, sp);
+    return lower_bound(k);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::
+erase_at(leaf_ptr l, size_type pos, search_path& sp) {
+    for (size_type i = pos; i + 1 < l->count; ++i)
+        l->values[i] = mystl::move(l->values[i + 1]);
+    --l->count;
+    l->values[l->count] = value_type();
+    --m_size;
+    if (sp.depth > 0 && l->count < leaf_min)
+        fix_leaf_underflow(l, sp);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::
+fix_leaf_underflow(leaf_ptr l, search_path& sp) {
+    inner_ptr p = sp.path[sp.depth - 1];
+    const size_type i = sp.slot[sp.depth - 1];
+    leaf_ptr left = i > 0 ? static_cast<leaf_ptr>(p->children[i - 1]) : nullptr;
+    leaf_ptr right = i < p->count ? static_cast<leaf_ptr>(p->children[i + 1]) : nullptr;
+
+    if (left && left->count > leaf_min) {
+        // 从左兄弟借最后一个元素
+        for (size_type j = l->count; j > 0; --j)
+            l->values[j] = mystl::move(l->values[j - 1]);
+        --left->count;
+        l->values[0] = mystl::move(left->values[left->count]);
+        left->values[left->count] = value_type();
+        ++l->count;
+        p->keys[i - 1] = key(l->values[0]);
+        return;
+    }
+    if (right && right->count > leaf_min) {
+        // 从右兄弟借第一个元素
+        l->values[l->count] = mystl::move(right->values[0]);
+        ++l->count;
+        for (size_type j = 0; j + 1 < right->count; ++j)
+            right->values[j] = mystl::move(right->values[j + 1]);
+        --right->count;
+        right->values[right->count] = value_type();
+        p->keys[i] = key(right->values[0]);
+        return;
+    }
+
+    // 两边都不能借：与兄弟合并，右边的叶子并入左边后释放
+    leaf_ptr a = left ? left : l;
+    leaf_ptr b = left ? l : right;
+    for (size_type j = 0; j < b->count; ++j)
+        a->values[a->count + j] = mystl::move(b->values[j]);
+    a->count = static_cast<unsigned short>(a->count + b->count);
+    a->next = b->next;
+    if (b->next) b->next->prev = a;
+    else m_last = a;
+    destroy_leaf(b);
+    inner_remove_at(p, left ? i - 1 : i);
+    fix_inner_underflow(sp, sp.depth - 1);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, NodeBytes>::
+fix_inner_underflow(search_path& sp, int level) {
+    while (true) {
+        inner_ptr n = sp.path[level];
+        if (level == 0) {
+            // 根只剩一个孩子时树降低一层
+            if (n->count == 0) {
+                m_root = n->children[0];
+                destroy_inner(n);
+            }
+            return;
+        }
+        if (n->count >= inner_min) return;
+
+        inner_ptr p = sp.path[level - 1];
+        const size_type i = sp.slot[level - 1];
+        inner_ptr left = i > 0 ? static_cast<inner_ptr>(p->children[i - 1]) : nullptr;
+        inner_ptr right = i < p->count ? static_cast<inner_ptr>(p->children[i + 1]) : nullptr;
+
+        if (left && left->count > inner_min) {
+            // 经父节点右旋：父分隔键下移到 n 的最前，左兄弟的最后一个键上移
+            n->children[n->count + 1] = n->children[n->count];
+            for (size_type j = n->count; j > 0; --j) {
+                n->keys[j] = mystl::move(n->keys[j - 1]);
+                n->children[j] = n->children[j - 1];
+            }
+            n->keys[0] = mystl::move(p->keys[i - 1]);
+            n->children[0] = left->children[left->count];
+            ++n->count;
+            --left->count;
+            p->keys[i - 1] = mystl::move(left->keys[left->count]);
+            left->keys[left->count] = key_type();
+            return;
+        }
+        if (right && right->count > inner_min) {
+            // 经父节点左旋
+            n->keys[n->count] = mystl::move(p->keys[i]);
+            n->children[n->count + 1] = right->children[0];
+            ++n->count;
+            p->keys[i] = mystl::move(right->keys[0]);
+            for (size_type j = 0; j + 1 < right->count; ++j) {
+                right->keys[j] = mystl::move(right->keys[j + 1]);
+                right->children[j] = right->children[j + 1];
+            }
+            right->children[right->count - 1] = right->children[right->count];
+            --right->count;
+            right->keys[right->count] = key_type();
+            return;
+        }
+
+        // 合并：a + 分隔键 + b，b 释放，父节点少一个键后继续向上检查
+        inner_ptr a = left ? left : n;
+        inner_ptr b = left ? n : right;
+        const size_type sep = left ? i - 1 : i;
+        a->keys[a->count] = mystl::move(p->keys[sep]);
+        for (size_type j = 0; j < b->count; ++j) {
+            a->keys[a->count + 1 + j] = mystl::move(b->keys[j]);
+            a->children[a->count + 1 + j] = b->children[j];
+        }
+        a->children[a->count + 1 + b->count] = b->children[b->count];
+        a->count = static_cast<unsigned short>(a->count + 1 + b->count);
+        destroy_inner(b);
+        inner_remove_at(p, sep);
+        --level;
+    }
+}
+
+}
+#endif
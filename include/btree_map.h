@@ -0,0 +1,59 @@
+#ifndef BTREE_MAP_H
+#define BTREE_MAP_H
+
+#include "btree.h"
+
+namespace mystl {
+
+// 以 B+ 树为底层的 map，接口与 map.h 一致
+// NodeBytes 为每个节点的大致字节数：64 的倍数贴合 cache line，4096 贴合页
+// 与 map 不同，插入和删除会使所有迭代器失效
+template <class Key, class Value, class Compare = less<Key>, size_t NodeBytes = 256>
+class btree_map {
+public:
+    typedef Key                                         key_type;
+    typedef pair<key_type, Value>                       value_type;
+    typedef Compare                                     key_compare;
+private:
+    typedef mystl::btree<Key, value_type, select1st<value_type>, key_compare, NodeBytes>  base_type;
+    base_type m_tree;
+
+public:
+    typedef typename base_type::iterator                iterator;
+    typedef typename base_type::difference_type         difference_type;
+    typedef typename base_type::size_type               size_type;
+    typedef typename base_type::reference               reference;
+    typedef typename base_type::const_reference         const_reference;
+
+public:
+    btree_map() {}
+    template <class InputIter>
+    btree_map(InputIter first, InputIter last) { insert(first, last); }
+
+public:
+    pair<iterator, bool> insert(const value_type& val) { return m_tree.insert_unique(val); }
+    // B+ 树的查找路径很短，不使用提示
+    iterator insert(iterator, const value_type& val) { return m_tree.insert_unique(val).first; }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) {
+        for (; first != last; ++first)
+            m_tree.insert_unique(*first);
+    }
+    iterator erase(const iterator& it) { return m_tree.erase(it); }
+    size_type erase(const key_type& key) { return m_tree.erase(key); }
+    void clear() { m_tree.clear(); }
+
+    iterator begin() { return m_tree.begin(); }
+    iterator end() { return m_tree.end(); }
+
+    iterator find(const key_type& key) { return m_tree.find(key); }
+    iterator lower_bound(const key_type& key) { return m_tree.lower_bound(key); }
+
+    size_type size() { return m_tree.size(); }
+    bool empty() { return m_tree.empty(); }
+    // 节点占用的总字节数
+    size_type memory_usage() const { return m_tree.memory_usage(); }
+};
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef BTREE_SET_H
+#define BTREE_SET_H
+
+#include "btree.h"
+
+namespace mystl {
+
+// 以 B+ 树为底层的 set，接口与 set.h 一致
+// NodeBytes 为每个节点的大致字节数；插入和删除会使所有迭代器失效
+template <class value_type, class Compare = less<value_type>, size_t NodeBytes = 256>
+class btree_set {
+private:
+    typedef mystl::btree<value_type, value_type, identity<value_type>, Compare, NodeBytes>  base_type;
+    base_type m_tree;
+
+public:
+    typedef typename base_type::iterator                iterator;
+    typedef typename base_type::difference_type         difference_type;
+    typedef typename base_type::size_type               size_type;
+    typedef typename base_type::reference               reference;
+    typedef typename base_type::const_reference         const_reference;
+
+    typedef value_type                                  key_type;
+    typedef Compare                                     key_compare;
+
+public:
+    btree_set() {}
+    template <class InputIter>
+    btree_set(InputIter first, InputIter last) { insert(first, last); }
+
+public:
+    // 插入删除
+    pair<iterator, bool> insert(const value_type& value)
+    {
+        return m_tree.insert_unique(value);
+    }
+    // B+ 树的查找路径很短，不使用提示
+    iterator insert(iterator, const value_type& value)
+    {
+        return m_tree.insert_unique(value).first;
+    }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last)
+    {
+        for (; first != last; ++first)
+            m_tree.insert_unique(*first);
+    }
+    iterator erase(iterator it) { return m_tree.erase(it); }
+    size_type erase(const value_type& value) { return m_tree.erase(value); }
+    void clear() { m_tree.clear(); }
+
+    //查找
+    iterator find(const value_type& val) { return m_tree.find(val); }
+    iterator lower_bound(const value_type& val) { return m_tree.lower_bound(val); }
+
+    // 容量函数
+    size_type size() const { return m_tree.size(); }
+    bool empty() const { return m_tree.empty(); }
+    // 节点占用的总字节数
+    size_type memory_usage() const { return m_tree.memory_usage(); }
+
+    iterator begin() { return m_tree.begin(); }
+    iterator end() { return m_tree.end(); }
+};
+
+}
+#endif
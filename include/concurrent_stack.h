@@ -0,0 +1,173 @@
+#ifndef CONCURRENT_STACK_H
+#define CONCURRENT_STACK_H
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include "allocator.h"
+#include "construct.h"
+#include "util.h"
+namespace mystl {
+
+// 无锁 Treiber 栈，可作为线程间共享的对象池使用
+// 栈顶为 tagged pointer：低 48 位为节点地址，高 16 位为版本号，每次 CAS 版本号加一以避免 ABA
+// 弹出的节点不归还给分配器，而是进入内部的空闲栈复用，保证并发读取 next 时节点内存始终有效
+template <class T>
+class concurrent_stack {
+    static_assert(sizeof(void*) == 8, "concurrent_stack packs a 16-bit tag into 64-bit pointers");
+
+    struct node {
+        std::atomic<node*>  next;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        node() : next(nullptr) {}
+        T* value() { return reinterpret_cast<T*>(storage); }
+    };
+
+    typedef uint64_t        tagged_type;
+    typedef alloc<node>     node_allocator;
+
+    static constexpr tagged_type ptr_mask = (static_cast<tagged_type>(1) << 48) - 1;
+
+    static node* get_ptr(tagged_type v) { return reinterpret_cast<node*>(v & ptr_mask); }
+    static tagged_type next_tag(tagged_type v, node* p) {
+        return (reinterpret_cast<tagged_type>(p) & ptr_mask) | ((v & ~ptr_mask) + (ptr_mask + 1));
+    }
+
+public:
+    typedef T               value_type;
+    typedef T&              reference;
+    typedef const T&        const_reference;
+    typedef size_t          size_type;
+
+public:
+    concurrent_stack() : m_top(0), m_free(0) {}
+    ~concurrent_stack();
+    concurrent_stack(const concurrent_stack&) = delete;
+    concurrent_stack& operator= (const concurrent_stack&) = delete;
+
+    // 快照，仅用于提示
+    bool empty() const { return get_ptr(m_top.load(std::memory_order_acquire)) == nullptr; }
+
+    void push(const_reference x);
+    void push(value_type&& x);
+    bool pop(reference out);
+
+    // 一次 CAS 摘下整条链，按 LIFO 顺序对每个元素调用 f，返回元素个数
+    template <class F>
+    size_type pop_all(F f);
+
+private:
+    node* get_node();
+    static void push_chain(std::atomic<tagged_type>& head, node* first, node* last);
+    static node* pop_node(std::atomic<tagged_type>& head);
+    static node* take_all(std::atomic<tagged_type>& head);
+
+private:
+    alignas(64) std::atomic<tagged_type>    m_top;
+    alignas(64) std::atomic<tagged_type>    m_free;
+};
+
+template <class T>
+concurrent_stack<T>::~concurrent_stack() {
+    node* p = get_ptr(m_top.load(std::memory_order_relaxed));
+    while (p) {
+        node* next = p->next.load(std::memory_order_relaxed);
+        destory(p->value());
+        node_allocator::deallocate(p);
+        p = next;
+    }
+    p = get_ptr(m_free.load(std::memory_order_relaxed));
+    while (p) {
+        node* next = p->next.load(std::memory_order_relaxed);
+        node_allocator::deallocate(p);
+        p = next;
+    }
+}
+
+// 把 first..last 这条已经链好的链表整体压入 head
+template <class T>
+void concurrent_stack<T>::push_chain(std::atomic<tagged_type>& head, node* first, node* last) {
+    tagged_type old = head.load(std::memory_order_relaxed);
+    do {
+        last->next.store(get_ptr(old), std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(old, next_tag(old, first),
+                                         std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <class T>
+typename concurrent_stack<T>::node* concurrent_stack<T>::pop_node(std::atomic<tagged_type>& head) {
+    tagged_type old = head.load(std::memory_order_acquire);
+    node* p;
+    do {
+        p = get_ptr(old);
+        if (p == nullptr) return nullptr;
+        // p 可能已被其它线程弹出并复用，此时读到的 next 是脏值，但版本号变化会令 CAS 失败
+    } while (!head.compare_exchange_weak(old, next_tag(old, p->next.load(std::memory_order_relaxed)),
+                                         std::memory_order_acquire, std::memory_order_acquire));
+    return p;
+}
+
+template <class T>
+typename concurrent_stack<T>::node* concurrent_stack<T>::take_all(std::atomic<tagged_type>& head) {
+    tagged_type old = head.load(std::memory_order_acquire);
+    while (get_ptr(old) != nullptr &&
+           !head.compare_exchange_weak(old, next_tag(old, nullptr),
+                                       std::memory_order_acquire, std::memory_order_acquire)) {}
+    return get_ptr(old);
+}
+
+template <class T>
+typename concurrent_stack<T>::node* concurrent_stack<T>::get_node() {
+    node* p = pop_node(m_free);
+    if (p == nullptr) {
+        p = node_allocator::allocate();
+        ::new (static_cast<void*>(p)) node();
+    }
+    return p;
+}
+
+template <class T>
+void concurrent_stack<T>::push(const_reference x) {
+    node* p = get_node();
+    ::new (static_cast<void*>(p->value())) T(x);
+    push_chain(m_top, p, p);
+}
+
+template <class T>
+void concurrent_stack<T>::push(value_type&& x) {
+    node* p = get_node();
+    ::new (static_cast<void*>(p->value())) T(mystl::move(x));
+    push_chain(m_top, p, p);
+}
+
+template <class T>
+bool concurrent_stack<T>::pop(reference out) {
+    node* p = pop_node(m_top);
+    if (p == nullptr) return false;
+    out = mystl::move(*p->value());
+    destory(p->value());
+    push_chain(m_free, p, p);
+    return true;
+}
+
+template <class T>
+template <class F>
+typename concurrent_stack<T>::size_type concurrent_stack<T>::pop_all(F f) {
+    node* first = take_all(m_top);
+    if (first == nullptr) return 0;
+    size_type n = 0;
+    node* last = first;
+    for (node* p = first; p; p = p->next.load(std::memory_order_relaxed)) {
+        f(*p->value());
+        destory(p->value());
+        last = p;
+        ++n;
+    }
+    // 整条链一次性归还到空闲栈
+    push_chain(m_free, first, last);
+    return n;
+}
+
+}
+#endif
@@ -9,7 +9,7 @@ namespace mystl{
 //全局construct  调用placement new
 template<class Pointer, class T>
 inline void construct(Pointer p, T&& x) {
-    new(p) T(move(x));
+    new(p) T(mystl::move(x));
 }
 
 template<class Pointer, class T>
@@ -1,7 +1,9 @@
 #ifndef DEQUE_H
 #define DEQUE_H
 #include "iterator.h"
+#include "allocator.h"
 #include "initialized.h"
+#include <assert.h>
 #include <initializer_list>
 #include "algo.h"
 namespace mystl{
@@ -0,0 +1,59 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include "flat_tree.h"
+
+namespace mystl {
+
+// 以有序 vector 为底层的 map，接口与 map.h 一致
+// 没有节点开销，查找为连续内存上的二分；插入删除 O(n)，批量数据请用区间构造或区间插入
+template <class Key, class Value, class Compare = less<Key>>
+class flat_map {
+public:
+    typedef Key                                         key_type;
+    typedef pair<key_type, Value>                       value_type;
+    typedef Compare                                     key_compare;
+private:
+    typedef mystl::flat_tree<Key, value_type, select1st<value_type>, key_compare>  base_type;
+    base_type m_tree;
+
+public:
+    typedef typename base_type::iterator                iterator;
+    typedef typename base_type::difference_type         difference_type;
+    typedef typename base_type::size_type               size_type;
+    typedef typename base_type::reference               reference;
+    typedef typename base_type::const_reference         const_reference;
+
+public:
+    flat_map() {}
+    // 区间构造：排序去重后一次建成
+    template <class InputIter>
+    flat_map(InputIter first, InputIter last) { m_tree.insert_unique(first, last); }
+
+public:
+    pair<iterator, bool> insert(const value_type& val) { return m_tree.insert_unique(val); }
+    // hint 恰好是插入位置时省去二分，有序输入可传 end()
+    iterator insert(iterator hint, const value_type& val) { return m_tree.insert_unique(hint, val); }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { m_tree.insert_unique(first, last); }
+    // 同 insert(first, last)：新值排序后与原有元素归并一次
+    template <class InputIter>
+    void insert_range(InputIter first, InputIter last) { m_tree.insert_unique(first, last); }
+    iterator erase(const iterator& it) { return m_tree.erase(it); }
+    size_type erase(const key_type& key) { return m_tree.erase(key); }
+    void clear() { m_tree.clear(); }
+
+    iterator begin() { return m_tree.begin(); }
+    iterator end() { return m_tree.end(); }
+
+    iterator find(const key_type& key) { return m_tree.find(key); }
+    iterator lower_bound(const key_type& key) { return m_tree.lower_bound(key); }
+    iterator upper_bound(const key_type& key) { return m_tree.upper_bound(key); }
+
+    size_type size() { return m_tree.size(); }
+    bool empty() { return m_tree.empty(); }
+    void reserve(size_type n) { m_tree.reserve(n); }
+};
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef FLAT_SET_H
+#define FLAT_SET_H
+
+#include "flat_tree.h"
+
+namespace mystl {
+
+// 以有序 vector 为底层的 set，接口与 set.h 一致
+// 没有节点开销，查找为连续内存上的二分；插入删除 O(n)，批量数据请用区间构造或区间插入
+template <class value_type, class Compare = less<value_type>>
+class flat_set {
+private:
+    typedef mystl::flat_tree<value_type, value_type, identity<value_type>, Compare>  base_type;
+    base_type m_tree;
+
+public:
+    typedef typename base_type::iterator                iterator;
+    typedef typename base_type::difference_type         difference_type;
+    typedef typename base_type::size_type               size_type;
+    typedef typename base_type::reference               reference;
+    typedef typename base_type::const_reference         const_reference;
+
+    typedef value_type                                  key_type;
+    typedef Compare                                     key_compare;
+
+public:
+    flat_set() {}
+    // 区间构造：排序去重后一次建成
+    template <class InputIter>
+    flat_set(InputIter first, InputIter last) { m_tree.insert_unique(first, last); }
+
+public:
+    // 插入删除
+    pair<iterator, bool> insert(const value_type& value)
+    {
+        return m_tree.insert_unique(value);
+    }
+    // hint 恰好是插入位置时省去二分，有序输入可传 end()
+    iterator insert(iterator hint, const value_type& value)
+    {
+        return m_tree.insert_unique(hint, value);
+    }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { m_tree.insert_unique(first, last); }
+    // 同 insert(first, last)：新值排序后与原有元素归并一次
+    template <class InputIter>
+    void insert_range(InputIter first, InputIter last) { m_tree.insert_unique(first, last); }
+    iterator erase(iterator it) { return m_tree.erase(it); }
+    size_type erase(const value_type& value) { return m_tree.erase(value); }
+    void clear() { m_tree.clear(); }
+
+    //查找
+    iterator find(const value_type& val) { return m_tree.find(val); }
+    iterator lower_bound(const value_type& val) { return m_tree.lower_bound(val); }
+    iterator upper_bound(const value_type& val) { return m_tree.upper_bound(val); }
+
+    // 容量函数
+    size_type size() const { return m_tree.size(); }
+    bool empty() const { return m_tree.empty(); }
+    void reserve(size_type n) { m_tree.reserve(n); }
+
+    iterator begin() { return m_tree.begin(); }
+    iterator end() { return m_tree.end(); }
+};
+
+}
+#endif
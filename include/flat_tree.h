@@ -0,0 +1,209 @@
+#ifndef FLAT_TREE_H
+#define FLAT_TREE_H
+
+#include "vector.h"
+#include "algo.h"
+#include "functional.h"
+#include "pair.h"
+
+namespace mystl {
+
+// 有序 vector 上的查找结构，flat_map / flat_set 的底层
+// 元素按键升序连续存放，查找为二分，插入删除需要移动后面的元素 O(n)，
+// 适合读多写少、可以批量构造的场景；插入和删除会使迭代器失效
+template <class Key, class Value, class KeyOfValue, class Compare>
+class flat_tree {
+public:
+    typedef vector<Value>                               container_type;
+    typedef typename container_type::iterator           iterator;
+    typedef typename container_type::value_type         value_type;
+    typedef typename container_type::pointer            pointer;
+    typedef typename container_type::reference          reference;
+    typedef typename container_type::const_reference    const_reference;
+    typedef typename container_type::size_type          size_type;
+    typedef typename container_type::difference_type    difference_type;
+
+    typedef Key                                         key_type;
+    typedef Compare                                     key_compare;
+
+private:
+    key_compare comp;
+    container_type m_data;
+
+    const key_type& key(const value_type& val) const { return KeyOfValue()(val); }
+
+    // 比较两个值的键，供排序使用
+    struct value_compare {
+        flat_tree* tree;
+        bool operator() (const value_type& a, const value_type& b) {
+            return tree->comp(tree->key(a), tree->key(b));
+        }
+    };
+
+public:
+    flat_tree() {}
+
+    iterator begin() { return m_data.begin(); }
+    iterator end() { return m_data.end(); }
+    size_type size() const { return m_data.size(); }
+    bool empty() const { return m_data.empty(); }
+    size_type capacity() const { return m_data.capacity(); }
+    void reserve(size_type n) { m_data.reserve(n); }
+    void clear() { m_data.clear(); }
+
+// 查找
+public:
+    // 第一个键不小于 k 的元素
+    iterator lower_bound(const key_type& k);
+    // 第一个键大于 k 的元素
+    iterator upper_bound(const key_type& k);
+    iterator find(const key_type& k);
+
+// 插入删除
+public:
+    pair<iterator, bool> insert_unique(const value_type& x);
+    // hint 恰好是新键的插入位置时省去二分查找，否则退化为普通插入
+    iterator insert_unique(iterator hint, const value_type& x);
+    // 区间插入：新值先稳定排序去重 (已有序时跳过排序)，再与原有元素一次归并，O(n + m log m)；
+    // 已有的键保留原元素，区间内键重复时保留最先出现的值
+    template <class InputIter>
+    void insert_unique(InputIter first, InputIter last);
+
+    iterator erase(iterator it) { return m_data.erase(it); }
+    size_type erase(const key_type& k);
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare>
+typename flat_tree<Key, Value, KeyOfValue, Compare>::iterator
+flat_tree<Key, Value, KeyOfValue, Compare>::lower_bound(const key_type& k)
+{
+    iterator first = begin();
+    size_type len = size();
+    while (len > 0) {
+        const size_type half = len / 2;
+        if (comp(key(first[half]), k)) {
+            first += half + 1;
+            len -= half + 1;
+        }
+        else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare>
+typename flat_tree<Key, Value, KeyOfValue, Compare>::iterator
+flat_tree<Key, Value, KeyOfValue, Compare>::upper_bound(const key_type& k)
+{
+    iterator first = begin();
+    size_type len = size();
+    while (len > 0) {
+        const size_type half = len / 2;
+        if (!comp(k, key(first[half]))) {
+            first += half + 1;
+            len -= half + 1;
+        }
+        else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare>
+typename flat_tree<Key, Value, KeyOfValue, Compare>::iterator
+flat_tree<Key, Value, KeyOfValue, Compare>::find(const key_type& k)
+{
+    iterator it = lower_bound(k);
+    if (it != end() && !comp(k, key(*it))) return it;
+    return end();
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare>
+pair<typename flat_tree<Key, Value, KeyOfValue, Compare>::iterator, bool>
+flat_tree<Key, Value, KeyOfValue, Compare>::insert_unique(const value_type& x)
+{
+    const key_type& k = key(x);
+    iterator it = lower_bound(k);
+    if (it != end() && !comp(k, key(*it)))
+        return pair<iterator, bool>(it, false);
+    return pair<iterator, bool>(m_data.insert(it, x), true);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare>
+typename flat_tree<Key, Value, KeyOfValue, Compare>::iterator
+flat_tree<Key, Value, KeyOfValue, Compare>::insert_unique(iterator hint, const value_type& x)
+{
+    const key_type& k = key(x);
+    if ((hint == begin() || comp(key(hint[-1]), k)) &&
+        (hint == end() || comp(k, key(*hint))))
+        return m_data.insert(hint, x);
+    return insert_unique(x).first;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare>
+template <class InputIter>
+void flat_tree<Key, Value, KeyOfValue, Compare>::insert_unique(InputIter first, InputIter last)
+{
+    container_type values;
+    for (; first != last; ++first)
+        values.push_back(*first);
+    value_type* v = values.begin();
+    size_type n = values.size();
+    if (n == 0) return;
+
+    value_compare vcomp = { this };
+    for (size_type i = 1; i < n; ++i) {
+        if (vcomp(v[i], v[i - 1])) {  // 不是非降序才排序，稳定排序使等键值的值保持输入顺序
+            mystl::stable_sort(v, v + n, vcomp);
+            break;
+        }
+    }
+    // 去掉键重复的值，只保留每组的第一个
+    size_type m = 1;
+    for (size_type i = 1; i < n; ++i) {
+        if (vcomp(v[m - 1], v[i])) {
+            if (m != i) v[m] = v[i];
+            ++m;
+        }
+    }
+
+    // 新值都在原有元素之后时直接追加
+    if (empty() || vcomp(m_data.back(), v[0])) {
+        m_data.reserve(size() + m);
+        for (size_type i = 0; i < m; ++i)
+            m_data.push_back(mystl::move(v[i]));
+        return;
+    }
+
+    // 一次归并到新的缓冲区，键重复时保留原有元素
+    container_type merged;
+    merged.reserve(size() + m);
+    iterator cur = begin();
+    size_type i = 0;
+    while (cur != end() || i < m) {
+        if (cur == end() || (i < m && vcomp(v[i], *cur))) {
+            merged.push_back(mystl::move(v[i++]));
+        }
+        else {
+            if (i < m && !vcomp(*cur, v[i]))
+                ++i;
+            merged.push_back(mystl::move(*cur++));
+        }
+    }
+    m_data.swap(merged);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare>
+typename flat_tree<Key, Value, KeyOfValue, Compare>::size_type
+flat_tree<Key, Value, KeyOfValue, Compare>::erase(const key_type& k)
+{
+    iterator it = find(k);
+    if (it == end()) return 0;
+    m_data.erase(it);
+    return 1;
+}
+
+}
+#endif
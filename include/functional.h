@@ -5,13 +5,13 @@
 #include <cstddef>
 namespace mystl {
     // 函数对象：等于
-template <class T>
+template <class T = void>
 struct equal_to
 {
   bool operator()(const T& x, const T& y) const { return x == y; }
 };
 
-template <class T>
+template <class T = void>
 class less {
 public:
     bool operator() (const T& a, const T& b) {
@@ -19,6 +19,44 @@ public:
     }
 };
 
+template <class T = void>
+class greater {
+public:
+    bool operator() (const T& a, const T& b) {
+        return b < a;
+    }
+};
+
+// 透明版本 (equal_to<> / less<> / greater<>)：两个参数可以是不同类型，
+// 带 is_transparent 标记的比较器让容器的 find 等接受与键可比较的任意类型，不必先构造一个键
+template <>
+struct equal_to<void>
+{
+  typedef void is_transparent;
+  template <class T, class U>
+  bool operator()(const T& x, const U& y) const { return x == y; }
+};
+
+template <>
+class less<void> {
+public:
+    typedef void is_transparent;
+    template <class T, class U>
+    bool operator() (const T& a, const U& b) const {
+        return a < b;
+    }
+};
+
+template <>
+class greater<void> {
+public:
+    typedef void is_transparent;
+    template <class T, class U>
+    bool operator() (const T& a, const U& b) const {
+        return b < a;
+    }
+};
+
 template <class T>
 class identity {
 public:
@@ -40,7 +78,7 @@ public:
 // 哈希函数对象
 
 // 对于大部分类型，hash function 什么都不做
-template <class Key>
+template <class Key = void>
 struct hash {};
 
 // 针对指针的偏特化版本
@@ -137,6 +175,16 @@ struct hash<long double>
   }
 };
 
+// 透明版本 hash<>：按实参类型选用 hash<T>
+// 与 equal_to<> 一起使用时，相等的不同类型的值必须得到相同的哈希值 (如各种整型之间)
+template <>
+struct hash<void>
+{
+  typedef void is_transparent;
+  template <class T>
+  size_t operator()(const T& val) const { return hash<T>()(val); }
+};
+
 }
 
 #endif
\ No newline at end of file
@@ -52,7 +52,7 @@ public:
         node = node->next;
         if (node == nullptr)
         { // 如果下一个位置为空，跳到下一个 bucket 的起始处
-        auto index = ht->hash(Extract()(old->value));
+        auto index = ht->hash(Extract()(old->value), ht->bucket_size);
         while (!node && ++index < ht->bucket_size)
             node = ht->buckets[index];
         }
@@ -143,7 +143,7 @@ public:
     Extract     key;
 public:
 //构造函数
-    explicit hash_table(size_type bucket_count = 1) : m_size(0),bucket_size(1) {
+    explicit hash_table(size_type bucket_count = 1) : bucket_size(1), m_size(0) {
         init(bucket_count);
     }
 
@@ -170,15 +170,22 @@ public:
     pair<iterator, bool> insert_unique(const value_type& val);
 
 // 查找
-    iterator find(const key_type& key);
+    iterator find(const key_type& key) { return find_node(key); }
+    // Equal 和 HashFuc 都带 is_transparent 标记 (如 equal_to<> 与 hash<>) 时，
+    // 可以直接用能与键比较的其他类型查找，不构造临时的 key_type
+    template <class K, class E = Equal, class H = HashFuc,
+              class = typename E::is_transparent, class = typename H::is_transparent>
+    iterator find(const K& key) { return find_node(key); }
 private:
 //node
     node_ptr create_node(const value_type& val);    
     void destroy_node(node_ptr ptr);
+    template <class K>
+    iterator find_node(const K& key);
 //hash
     void rehash(size_type n);
-    size_type hash(const key_type& key, size_type n) const;
-    size_type hash(const key_type& key) const;
+    template <class K>
+    size_type hash(const K& key, size_type n) const { return m_hash(key) % n; }
 };
 
 template <class Key, class Value, class Extract, class Equal, class HashFuc>
@@ -187,7 +194,8 @@ init(size_type n)  {
     const auto bucket_nums = ht_next_prime(n);
     try
     {
-        buckets.reserve(bucket_nums);
+        bucket_type tmp(bucket_nums, nullptr);
+        buckets.swap(tmp);
     }
     catch (...)
     {
@@ -272,97 +280,38 @@ insert_unique(const value_type& value)
     return mystl::make_pair(iterator(tmp, this), true);
 }
 
+// 元素个数将超过桶数时扩容：原有节点直接挂到新桶上，不复制也不重新分配
 template <class Key, class Value, class Extract, class Equal, class HashFuc>
 void hash_table<Key, Value, Extract, Equal, HashFuc>::
 rehash(size_type count) 
 {
-    int need_size = count + m_size;
-    if (need_size > bucket_size) {
-        size_t bucket_count = ht_next_prime(need_size);
-        bucket_type bucket(bucket_count, nullptr);
-        
-        if (m_size != 0)
+    const size_type need_size = count + m_size;
+    if (need_size <= bucket_size)
+        return;
+    const size_type bucket_count = ht_next_prime(need_size);
+    bucket_type bucket(bucket_count, nullptr);
+    for (size_type i = 0; i < bucket_size; ++i)
+    {
+        node_ptr first = buckets[i];
+        while (first)
         {
-            for (size_type i = 0; i < bucket_size; ++i)
-            {
-                for (auto first = buckets[i]; first; first = first->next)
-                {   
-                    node_ptr tmp = create_node(first->value);
-                    //重新hash
-                    const auto n = hash(key(first->value), bucket_count);
-                    // printf(" n ::: %d\n", n);
-                    //插入到新的桶中
-                    auto f = bucket[n];
-                    bool is_inserted = false;
-                    for (auto cur = f; cur; cur = cur->next)
-                    {
-                        if (equal(key(cur->value), key(first->value)))
-                        {
-                            tmp->next = cur->next;
-                            cur->next = tmp;
-                            is_inserted = true;
-                            break;
-                        }
-                    }
-                    
-                    // 如果目标桶节点里面的hash不一或者没有节点就插入到头结点
-                    if (!is_inserted)
-                    {
-                        tmp->next = f;
-                        bucket[n] = tmp;
-                    }
-                    //if (bucket[i]) printf("bucket : %d  value: %d  add : %p\n", i, bucket[i]->value.second, bucket[i]);
-                }
-            }
-            // printf("\n");
-            // for (size_type i = 0; i < bucket_size; ++i) {
-            //     printf("a : %d  %p \n", i, bucket[i]);
-            // }
-            // todo
-            // printf("before %p %p \n", buckets.begin(), buckets.end());
-
-            auto t1 = buckets._first ;
-            auto t2 = buckets._finish;
-            auto t3 = buckets._end_store;
-            buckets._first = bucket._first;
-            buckets._finish = bucket._finish;
-            buckets._end_store = bucket._end_store;
-            bucket._first = t1;
-            bucket._finish = t2;
-            bucket._end_store = t3;
-
-            bucket_size = buckets.size();
-
-            
-            // printf("after %p %p \n", buckets.begin(), buckets.end());
-
-            // for (size_type i = 0; i < bucket_size; ++i) {
-            //     printf("after swap : %d  %p \n", i, buckets[i]);
-            // }
+            node_ptr next = first->next;
+            const auto n = hash(key(first->value), bucket_count);
+            first->next = bucket[n];
+            bucket[n] = first;
+            first = next;
         }
     }
+    buckets.swap(bucket);
+    bucket_size = buckets.size();
 }
 
 template <class Key, class Value, class Extract, class Equal, class HashFuc>
-typename hash_table<Key, Value, Extract, Equal, HashFuc>::size_type hash_table<Key, Value, Extract, Equal, HashFuc>::
-hash(const key_type& val) const
-{
-    return m_hash(val);
-}
-
-template <class Key, class Value, class Extract, class Equal, class HashFuc>
-typename hash_table<Key, Value, Extract, Equal, HashFuc>::size_type hash_table<Key, Value, Extract, Equal, HashFuc>::
-hash(const key_type& val, size_type n) const
-{
-    return m_hash(val) % n;
-}
-
-
-template <class Key, class Value, class Extract, class Equal, class HashFuc>
+template <class K>
 typename hash_table<Key, Value, Extract, Equal, HashFuc>::iterator
 hash_table<Key, Value, Extract, Equal, HashFuc>::
-find(const key_type& tkey) {
-    const auto n = hash(tkey);
+find_node(const K& tkey) {
+    const auto n = hash(tkey, bucket_size);
     node_ptr first = buckets[n];
     for (; first && !equal(key(first->value), tkey); first = first->next) {}
     return iterator(first, this);
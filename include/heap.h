@@ -2,87 +2,125 @@
 #define HEAP_H
 #include "vector.h"
 #include "iterator.h"
+#include "functional.h"
+#include "util.h"
 namespace mystl {
 
-template <class Iterator, 
-        class Distance = typename iterator_traits<Iterator>::difference_type,
-        class Compare>
-void make_heap(Iterator first, Iterator last, Compare cmp) {
-    auto len = last - first;
-    auto holeIdx = len / 2;
-    if (len < 2) return;
-
-    while (holeIdx) {
-        down_heap(first, holeIdx, len, *(first + holeIdx), cmp);
-        --holeIdx;
+// d 叉堆算法，下标从 0 开始：i 的孩子为 D*i+1 .. D*i+D，父节点为 (i-1)/D
+// Compare 语义与 std 一致：cmp(a, b) 为 true 表示 a 的优先级低于 b，默认 less 为大顶堆
+// 所有 sift 都是迭代的 "挖洞" 写法：沿路径只移动元素，最后一次性放入 value
+
+// Track 在元素被放到新位置时调用 track(元素, 下标)，供需要维护位置索引的堆使用
+struct heap_no_track {
+    template <class T, class Distance>
+    void operator() (T&, Distance) const {}
+};
+
+// 从 hole 向上浮动到不低于 top 的位置
+template <size_t D, class RandomIter, class Distance, class T, class Compare, class Track>
+void sift_up(RandomIter first, Distance hole, Distance top, T value, Compare& cmp, Track& track) {
+    while (hole > top) {
+        Distance parent = (hole - 1) / D;
+        if (!cmp(*(first + parent), value)) break;
+        *(first + hole) = mystl::move(*(first + parent));
+        track(*(first + hole), hole);
+        hole = parent;
     }
+    *(first + hole) = mystl::move(value);
+    track(*(first + hole), hole);
 }
 
-template <class Iterator
-        , class Distance
-        , class T
-        , class Compare>
-void down_heap(Iterator first, Distance holeIdx, Distance len, const T& value, Compare cmp) {
-    auto lchild = holeIdx * 2;
-    auto rchild = holeIdx * 2 + 1;
-    auto next = holeIdx;
-    if (lchild <= len && *(first + holeIdx) < *(first + lchild)) {
-        next = lchild;
-    }
-    if (rchild <= len && *(first + next) < *(first + rchild)) {
-        next = rchild;
-    }
-
-    if (next != holeIdx) {
-        *(first + holeIdx) = *(first + next);
-        down_heap(first, next, len, value, cmp);
-    }
-    else {
-        *(first + holeIdx) = value;
+// [first, first + len) 中 hole 处为空，把 value 下沉到合适位置
+template <size_t D, class RandomIter, class Distance, class T, class Compare, class Track>
+void sift_down(RandomIter first, Distance hole, Distance len, T value, Compare& cmp, Track& track) {
+    while (true) {
+        Distance child = D * hole + 1;
+        if (child >= len) break;
+        Distance last = child + static_cast<Distance>(D) < len ? child + static_cast<Distance>(D) : len;
+        Distance best = child;
+        for (Distance c = child + 1; c < last; ++c) {
+            if (cmp(*(first + best), *(first + c))) best = c;
+        }
+        if (!cmp(value, *(first + best))) break;
+        *(first + hole) = mystl::move(*(first + best));
+        track(*(first + hole), hole);
+        hole = best;
     }
+    *(first + hole) = mystl::move(value);
+    track(*(first + hole), hole);
 }
 
-template <class Iterator
-        , class Distance
-        , class T
-        , class Compare>
-void up_heap(Iterator first, Distance holeIdx, const T& value, Compare cmp) {
-    Distance parent = holeIdx / 2;   
-    if (parent) {
-        if (value > *(first + parent)) {
-            *(first + holeIdx) = *(first + parent);
-            up_heap(first, parent, value, cmp);
-        }
-        else {
-            *(first + holeIdx) = value;
-        }
-    }   
-    else {
-        if (value > *(first + holeIdx)) {
-            *(first + holeIdx) = value;
+// Floyd 的自底向上下沉：洞先沿最优孩子一路推到叶子 (每层只比较孩子之间)，
+// 再把 value 从叶子上浮。pop 时 value 来自堆尾，通常只需上浮很少几层
+template <size_t D, class RandomIter, class Distance, class T, class Compare, class Track>
+void sift_down_floyd(RandomIter first, Distance hole, Distance len, T value, Compare& cmp, Track& track) {
+    const Distance top = hole;
+    while (true) {
+        Distance child = D * hole + 1;
+        if (child >= len) break;
+        Distance last = child + static_cast<Distance>(D) < len ? child + static_cast<Distance>(D) : len;
+        Distance best = child;
+        for (Distance c = child + 1; c < last; ++c) {
+            if (cmp(*(first + best), *(first + c))) best = c;
         }
+        *(first + hole) = mystl::move(*(first + best));
+        track(*(first + hole), hole);
+        hole = best;
     }
+    sift_up<D>(first, hole, top, mystl::move(value), cmp, track);
 }
 
-template <class Iterator, class Compare>
-void pop_heap(Iterator first, Iterator last, typename iterator_traits<Iterator>::const_reference value, Compare cmp) {
-    down_heap(first, static_cast<ptrdiff_t>(1), last - first - 1, value, cmp);
-}
 
-template <class Iterator, class Compare, class T>
-void push_heap(Iterator first, Iterator last, const T& value, Compare cmp) {
-    up_heap(first, last - first - 1, value, cmp);
+// O(n) 建堆
+template <size_t D = 2, class RandomIter, class Compare, class Track>
+void make_heap(RandomIter first, RandomIter last, Compare cmp, Track track) {
+    typedef typename iterator_traits<RandomIter>::difference_type   Distance;
+    typedef typename iterator_traits<RandomIter>::value_type        T;
+    const Distance len = last - first;
+    if (len < 2) return;
+    for (Distance hole = (len - 2) / static_cast<Distance>(D); hole >= 0; --hole) {
+        T value = mystl::move(*(first + hole));
+        sift_down<D>(first, hole, len, mystl::move(value), cmp, track);
+    }
 }
 
+template <size_t D = 2, class RandomIter, class Compare>
+void make_heap(RandomIter first, RandomIter last, Compare cmp) {
+    make_heap<D>(first, last, cmp, heap_no_track());
+}
 
+// 新元素已放在 last - 1
+template <size_t D = 2, class RandomIter, class Compare, class Track>
+void push_heap(RandomIter first, RandomIter last, Compare cmp, Track track) {
+    typedef typename iterator_traits<RandomIter>::difference_type   Distance;
+    typedef typename iterator_traits<RandomIter>::value_type        T;
+    const Distance len = last - first;
+    if (len < 1) return;
+    T value = mystl::move(*(last - 1));
+    sift_up<D>(first, len - 1, static_cast<Distance>(0), mystl::move(value), cmp, track);
+}
 
+template <size_t D = 2, class RandomIter, class Compare>
+void push_heap(RandomIter first, RandomIter last, Compare cmp) {
+    push_heap<D>(first, last, cmp, heap_no_track());
+}
 
+// 把堆顶移到 last - 1，[first, last - 1) 仍然是堆
+template <size_t D = 2, class RandomIter, class Compare, class Track>
+void pop_heap(RandomIter first, RandomIter last, Compare cmp, Track track) {
+    typedef typename iterator_traits<RandomIter>::difference_type   Distance;
+    typedef typename iterator_traits<RandomIter>::value_type        T;
+    const Distance len = last - first;
+    if (len < 2) return;
+    T value = mystl::move(*(last - 1));
+    *(last - 1) = mystl::move(*first);
+    sift_down_floyd<D>(first, static_cast<Distance>(0), len - 1, mystl::move(value), cmp, track);
+}
 
-
-
-
-
-
+template <size_t D = 2, class RandomIter, class Compare>
+void pop_heap(RandomIter first, RandomIter last, Compare cmp) {
+    pop_heap<D>(first, last, cmp, heap_no_track());
+}
 
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,122 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+#include <assert.h>
+#include "vector.h"
+#include "heap.h"
+#include "functional.h"
+namespace mystl {
+
+// 带索引的优先队列：push 返回稳定的 handle，之后可按 handle 修改优先级或删除
+// 堆数组中只存 handle，元素按 handle 存放不移动；借助 heap.h 的 Track 回调维护 handle -> 堆下标
+template <class T, class Compare = mystl::less<T>, size_t D = 4>
+class indexed_priority_queue {
+public:
+    typedef T                   value_type;
+    typedef T&                  reference;
+    typedef const T&            const_reference;
+    typedef size_t              size_type;
+    typedef size_t              handle_type;
+    typedef Compare             compare_type;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    // 比较两个 handle 对应的元素
+    struct handle_compare {
+        indexed_priority_queue* q;
+        bool operator() (handle_type a, handle_type b) {
+            return q->cmp(q->m_values.begin()[a], q->m_values.begin()[b]);
+        }
+    };
+    // 元素移动到新堆下标时更新位置表
+    struct position_track {
+        size_type* pos;
+        void operator() (handle_type h, ptrdiff_t i) { pos[h] = static_cast<size_type>(i); }
+    };
+
+public:
+    size_type size() const { return m_heap.size(); }
+    bool empty() const { return m_heap.empty(); }
+
+    handle_type push(const_reference x);
+    reference top() { assert(!empty()); return m_values.begin()[m_heap.front()]; }
+    handle_type top_handle() { assert(!empty()); return m_heap.front(); }
+    void pop() { erase(top_handle()); }
+
+    // handle 是否仍在队列中
+    bool contains(handle_type h) const {
+        return h < m_pos.size() && m_pos[static_cast<int>(h)] != npos;
+    }
+    const_reference get(handle_type h) const { return m_values[static_cast<int>(h)]; }
+
+    // 修改优先级，可升可降，O(log n)
+    void update(handle_type h, const_reference x);
+    // 按 handle 删除，O(log n)；被删除的 handle 之后可能被 push 复用
+    void erase(handle_type h);
+
+private:
+    // 把 handle h 放到堆下标 hole 处并恢复堆序
+    void fix(handle_type h, ptrdiff_t hole);
+
+private:
+    vector<T>           m_values;   // handle -> 元素
+    vector<size_type>   m_pos;      // handle -> 堆下标，空闲 handle 为 npos
+    vector<handle_type> m_heap;     // 堆数组
+    vector<handle_type> m_free;     // 可复用的 handle
+    compare_type        cmp;
+};
+
+template <class T, class Compare, size_t D>
+void indexed_priority_queue<T, Compare, D>::fix(handle_type h, ptrdiff_t hole) {
+    handle_compare hc = { this };
+    position_track track = { m_pos.begin() };
+    handle_type* heap = m_heap.begin();
+    if (hole > 0 && hc(heap[(hole - 1) / D], h))
+        sift_up<D>(heap, hole, static_cast<ptrdiff_t>(0), h, hc, track);
+    else
+        sift_down<D>(heap, hole, static_cast<ptrdiff_t>(m_heap.size()), h, hc, track);
+}
+
+template <class T, class Compare, size_t D>
+typename indexed_priority_queue<T, Compare, D>::handle_type
+indexed_priority_queue<T, Compare, D>::push(const_reference x) {
+    handle_type h;
+    if (!m_free.empty()) {
+        h = m_free.back();
+        m_free.pop_back();
+        m_values.begin()[h] = x;
+    }
+    else {
+        h = m_values.size();
+        m_values.push_back(x);
+        m_pos.push_back(npos);
+    }
+    m_heap.push_back(h);
+    handle_compare hc = { this };
+    position_track track = { m_pos.begin() };
+    sift_up<D>(m_heap.begin(), static_cast<ptrdiff_t>(m_heap.size() - 1),
+               static_cast<ptrdiff_t>(0), h, hc, track);
+    return h;
+}
+
+template <class T, class Compare, size_t D>
+void indexed_priority_queue<T, Compare, D>::update(handle_type h, const_reference x) {
+    assert(contains(h));
+    m_values.begin()[h] = x;
+    fix(h, static_cast<ptrdiff_t>(m_pos.begin()[h]));
+}
+
+template <class T, class Compare, size_t D>
+void indexed_priority_queue<T, Compare, D>::erase(handle_type h) {
+    assert(contains(h));
+    const size_type hole = m_pos.begin()[h];
+    const handle_type last = m_heap.back();
+    m_heap.pop_back();
+    m_pos.begin()[h] = npos;
+    m_free.push_back(h);
+    if (hole < m_heap.size())
+        fix(last, static_cast<ptrdiff_t>(hole));
+}
+
+}
+#endif
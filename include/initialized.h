@@ -2,6 +2,7 @@
 #ifndef INTITIALIZED_H
 #define INTITIALIZED_H
 #include "construct.h"
+#include "iterator.h"
 #include <cstddef>
 
 
@@ -10,7 +11,7 @@ namespace mystl {
 template<class InputIt, class ForwardIt>
 ForwardIt initialize_copy(InputIt first, InputIt last, ForwardIt res) {
     for (; first != last; first++) {
-        construct(&*res++, forward<typename iterator_traits<ForwardIt>:: value_type>(*first));
+        construct(&*res++, mystl::forward<typename iterator_traits<ForwardIt>:: value_type>(*first));
     }
     return res;
 }
@@ -23,7 +24,7 @@ ForwardIt initialize_copy_r(InputIt first, InputIt last, ForwardIt res) {
     res += cnt - 1;
     --last;
     for (int i = 0; i < cnt; i++) {
-        construct(&*res--, forward<typename iterator_traits<ForwardIt>:: value_type>(*last--));
+        construct(&*res--, mystl::forward<typename iterator_traits<ForwardIt>:: value_type>(*last--));
     }
     return ret;
 }
@@ -33,7 +34,7 @@ template<class InputIt, class T>
 void initialize_fill(InputIt first, InputIt last, T&& x) 
 {
     for (; first != last; ++first) {
-        mystl::construct(&*first, forward<T>(x));
+        mystl::construct(&*first, mystl::forward<T>(x));
     }
 }
 
@@ -41,7 +42,7 @@ void initialize_fill(InputIt first, InputIt last, T&& x)
 template<class ForwardIt, class T>
 void initialize_fill_n(ForwardIt first, size_t n, T&& x) {
     for (size_t i = 0; i < n; ++i, ++first) {
-        mystl::construct(&*first, forward<T>(x));
+        mystl::construct(&*first, mystl::forward<T>(x));
     }
 }
     
@@ -0,0 +1,191 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include "iterator.h"
+#include <assert.h>
+namespace mystl {
+
+// 侵入式链表的链接钩子，嵌入到用户类型中 (作为基类或成员)
+// 链表不拥有元素：插入不分配、不复制，元素的生命周期由用户管理
+struct intrusive_list_hook {
+    intrusive_list_hook* prev;
+    intrusive_list_hook* next;
+
+    intrusive_list_hook() : prev(nullptr), next(nullptr) {}
+    // 钩子不随对象复制，副本处于未链接状态
+    intrusive_list_hook(const intrusive_list_hook&) : prev(nullptr), next(nullptr) {}
+    intrusive_list_hook& operator= (const intrusive_list_hook&) { return *this; }
+
+    bool is_linked() const { return next != nullptr; }
+};
+
+// 基类钩子，Tag 用于让同一个类型同时挂在多条链表上
+template <class Tag = void>
+struct intrusive_list_base_hook : public intrusive_list_hook {};
+
+
+// 钩子萃取：在元素指针与钩子指针之间转换
+template <class T, class Tag = void>
+struct base_hook {
+    typedef intrusive_list_base_hook<Tag>   hook_type;
+
+    static intrusive_list_hook* to_hook(T* p) { return static_cast<hook_type*>(p); }
+    static T* to_value(intrusive_list_hook* h) {
+        return static_cast<T*>(static_cast<hook_type*>(h));
+    }
+};
+
+template <class T, intrusive_list_hook T::* Member>
+struct member_hook {
+    static intrusive_list_hook* to_hook(T* p) { return &(p->*Member); }
+    static T* to_value(intrusive_list_hook* h) {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(h) - offset());
+    }
+
+private:
+    static ptrdiff_t offset() {
+        // 用一个非空的假地址计算成员偏移，等价于 offsetof
+        T* fake = reinterpret_cast<T*>(alignof(T) * 64);
+        return reinterpret_cast<char*>(&(fake->*Member)) - reinterpret_cast<char*>(fake);
+    }
+};
+
+
+template <class T, class Hook>
+struct intrusive_list_iterator : public iterator<bidirectional_iterator_tag, T> {
+    typedef intrusive_list_hook*                link_type;
+    typedef intrusive_list_iterator             self;
+
+    typedef typename self::iterator_category            iterator_category;
+    typedef typename self::value_type                   value_type;
+    typedef typename self::pointer                      pointer;
+    typedef typename self::reference                    reference;
+    typedef typename self::const_reference              const_reference;
+    typedef typename self::difference_type              difference_type;
+
+    link_type node;
+
+    // 构造函数
+    intrusive_list_iterator(const link_type& x) : node(x) {}
+    intrusive_list_iterator(const intrusive_list_iterator& rhs) : node(rhs.node) {}
+
+    bool operator== (const self& rhs) const { return node == rhs.node; }
+    bool operator!= (const self& rhs) const { return node != rhs.node; }
+
+    reference operator* () const { return *Hook::to_value(node); }
+    pointer operator-> () const { return &operator*(); }
+
+    self& operator++ () {
+        node = node->next;
+        return *this;
+    }
+    self operator++ (int) {
+        self temp = *this;
+        node = node->next;
+        return temp;
+    }
+    self& operator-- () {
+        node = node->prev;
+        return *this;
+    }
+    self operator-- (int) {
+        self temp = *this;
+        node = node->prev;
+        return temp;
+    }
+};
+
+
+// 侵入式双向链表，接口与 list.h 一致，另外支持由元素直接 O(1) 摘除
+template <class T, class Hook = base_hook<T>>
+class intrusive_list {
+public:
+    typedef T                       value_type;
+    typedef T*                      pointer;
+    typedef const T*                const_pointer;
+    typedef T&                      reference;
+    typedef const T&                const_reference;
+    typedef size_t                  size_type;
+    typedef ptrdiff_t               difference_type;
+
+    typedef intrusive_list_iterator<T, Hook>    iterator;
+    typedef intrusive_list_hook*                link_type;
+
+public:
+    intrusive_list() : m_size(0) {
+        m_header.next = &m_header;
+        m_header.prev = &m_header;
+    }
+    // 析构时只解除链接，不销毁元素
+    ~intrusive_list() { clear(); }
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator= (const intrusive_list&) = delete;
+
+    iterator begin() { return m_header.next; }
+    iterator end() { return &m_header; }
+    bool empty() const { return m_header.next == &m_header; }
+    size_type size() const { return m_size; }
+    reference front() { return *begin(); }
+    reference back() { return *(--end()); }
+
+    iterator insert(iterator it, reference x);
+    iterator erase(iterator it);
+    // 由元素本身摘除，O(1)，元素必须在本链表中
+    iterator erase(reference x) { return erase(iterator_to(x)); }
+    void clear();
+    void push_back(reference x) { insert(end(), x); }
+    void push_front(reference x) { insert(begin(), x); }
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(--end()); }
+
+    // 由元素得到指向它的迭代器
+    static iterator iterator_to(reference x) { return Hook::to_hook(&x); }
+
+private:
+    intrusive_list_hook m_header;
+    size_type           m_size;
+};
+
+template <class T, class Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::insert(iterator it, reference x) {
+    link_type temp = Hook::to_hook(&x);
+    assert(!temp->is_linked());
+    temp->next = it.node;
+    temp->prev = it.node->prev;
+    (it.node)->prev->next = temp;
+    (it.node)->prev = temp;
+    ++m_size;
+    return temp;
+}
+
+template <class T, class Hook>
+typename intrusive_list<T, Hook>::iterator
+intrusive_list<T, Hook>::erase(iterator it) {
+    assert(it.node != &m_header);
+    link_type temp = it.node;
+    link_type ret = temp->next;
+    temp->prev->next = temp->next;
+    temp->next->prev = temp->prev;
+    temp->prev = nullptr;
+    temp->next = nullptr;
+    --m_size;
+    return ret;
+}
+
+template <class T, class Hook>
+void intrusive_list<T, Hook>::clear() {
+    link_type cur = m_header.next;
+    while (cur != &m_header) {
+        link_type next = cur->next;
+        cur->prev = nullptr;
+        cur->next = nullptr;
+        cur = next;
+    }
+    m_header.next = &m_header;
+    m_header.prev = &m_header;
+    m_size = 0;
+}
+
+}
+#endif
@@ -4,6 +4,7 @@
 #include "iterator.h"
 #include "allocator.h"
 #include "initialized.h"
+#include "functional.h"
 #include <assert.h>
 namespace mystl {
 
@@ -83,27 +84,85 @@ public:
     list() {
         init();
     }
+    list(const list& rhs) {
+        init();
+        for (link_type p = rhs.node->next; p != rhs.node; p = p->next)
+            push_back(p->data);
+    }
+    list& operator= (const list& rhs) {
+        if (this != &rhs) {
+            clear();
+            for (link_type p = rhs.node->next; p != rhs.node; p = p->next)
+                push_back(p->data);
+        }
+        return *this;
+    }
+    ~list() {
+        clear();
+        trim_node_pool();
+        Alloc::deallocate(node);
+    }
 
 
     iterator begin() { return node->next; }
     iterator end() { return node; }
     bool empty() { return node->next == node; }
-    size_type size() { return distance(begin(), end()); }
+    size_type size() { return m_size; }
     reference front() { return *begin(); }
     reference back() { return *(--end()); }
 
     iterator insert(iterator it, const_reference x);
     iterator erase(iterator it);
+    void clear();
     void push_back(const_reference x) { insert(end(), x); }
     void push_front(const_reference x) { insert(begin(), x); }
     void pop_front() { erase(begin()); }
     void pop_back() { erase(--end()); }
 
+    // splice 只修改指针，不分配也不复制节点
+    void splice(iterator pos, list& x);
+    void splice(iterator pos, list& x, iterator it);
+    void splice(iterator pos, list& x, iterator first, iterator last);
+    // 已知 [first, last) 元素个数时为 O(1)，否则跨链表的区间 splice 需要 O(n) 计数
+    void splice(iterator pos, list& x, iterator first, iterator last, size_type n);
+
+    // 合并两个有序链表，x 被清空
+    void merge(list& x) { merge(x, mystl::less<T>()); }
+    template <class Compare>
+    void merge(list& x, Compare comp);
+
+    // 自底向上归并排序，稳定，只重新链接节点
+    void sort() { sort(mystl::less<T>()); }
+    template <class Compare>
+    void sort(Compare comp);
+
+    // 节点回收：erase 释放的节点最多保留 cap 个挂在空闲链上，供后续 insert 复用
+    // cap 为 0 (默认) 时关闭回收，行为与直接调用 Alloc 相同
+    void set_node_pool(size_type cap) {
+        m_pool_cap = cap;
+        trim_node_pool(cap);
+    }
+    size_type node_pool_size() const { return m_free_size; }
+    // 把空闲链缩减到最多 keep 个节点，其余归还给 Alloc
+    void trim_node_pool(size_type keep = 0);
+
 protected:
     link_type get_node() {
+        if (m_free) {
+            link_type p = m_free;
+            m_free = p->next;
+            --m_free_size;
+            return p;
+        }
         return static_cast<link_type>(Alloc::allocate());
     }
     void put_node(link_type p) {
+        if (m_free_size < m_pool_cap) {
+            p->next = m_free;
+            m_free = p;
+            ++m_free_size;
+            return;
+        }
         Alloc::deallocate(p);
     }
     void construct_node(link_type p) {
@@ -114,12 +173,31 @@ protected:
     }
 
     void init() {
+        m_free = nullptr;
+        m_free_size = 0;
+        m_pool_cap = 0;
         node = get_node();
-        construct_node(node);
         node->next = node;
         node->prev = node;
+        m_size = 0;
+    }
+
+    // 把 [first, last) 移到 pos 之前，不维护 m_size
+    static void transfer(link_type pos, link_type first, link_type last) {
+        if (pos == last) return;
+        link_type tail = last->prev;
+        first->prev->next = last;
+        last->prev = first->prev;
+
+        tail->next = pos;
+        first->prev = pos->prev;
+        pos->prev->next = first;
+        pos->prev = tail;
     }
 
+    template <class Compare>
+    static link_type merge_chain(link_type a, link_type b, Compare& comp);
+
 private:
     link_type create_one_node(const_reference x) {
         link_type ret = get_node();
@@ -129,6 +207,11 @@ private:
 
 private:
     link_type node;  
+    size_type m_size;
+
+    link_type m_free;       // 空闲节点链，经 next 串联
+    size_type m_free_size;
+    size_type m_pool_cap;
 };
 
 
@@ -139,6 +222,7 @@ typename list<T, Alloc>::iterator list<T, Alloc>::insert(iterator it, const_refe
     temp->prev = it.node->prev;
     (it.node)->prev->next = temp;
     (it.node)->prev = temp;
+    ++m_size;
     return temp;
 }
 
@@ -151,9 +235,154 @@ typename list<T, Alloc>::iterator list<T, Alloc>::erase(iterator it) {
     temp->next->prev = temp->prev;
     destory_node(temp);
     put_node(temp);
+    --m_size;
     return ret;
 }
 
+template<class T, class Alloc>
+void list<T, Alloc>::clear() {
+    link_type cur = node->next;
+    while (cur != node) {
+        link_type next = cur->next;
+        destory(&cur->data);
+        put_node(cur);
+        cur = next;
+    }
+    node->next = node;
+    node->prev = node;
+    m_size = 0;
+}
+
+template<class T, class Alloc>
+void list<T, Alloc>::trim_node_pool(size_type keep) {
+    while (m_free_size > keep) {
+        link_type p = m_free;
+        m_free = p->next;
+        --m_free_size;
+        Alloc::deallocate(p);
+    }
+}
+
+template<class T, class Alloc>
+void list<T, Alloc>::splice(iterator pos, list& x) {
+    if (this == &x || x.m_size == 0) return;
+    transfer(pos.node, x.node->next, x.node);
+    m_size += x.m_size;
+    x.m_size = 0;
+}
+
+template<class T, class Alloc>
+void list<T, Alloc>::splice(iterator pos, list& x, iterator it) {
+    link_type next = it.node->next;
+    if (pos.node == it.node || pos.node == next) return;
+    transfer(pos.node, it.node, next);
+    ++m_size;
+    --x.m_size;
+}
+
+template<class T, class Alloc>
+void list<T, Alloc>::splice(iterator pos, list& x, iterator first, iterator last) {
+    if (first == last) return;
+    size_type n = this == &x ? 0 : static_cast<size_type>(distance(first, last));
+    splice(pos, x, first, last, n);
+}
+
+template<class T, class Alloc>
+void list<T, Alloc>::splice(iterator pos, list& x, iterator first, iterator last, size_type n) {
+    if (first == last) return;
+    transfer(pos.node, first.node, last.node);
+    if (this != &x) {
+        m_size += n;
+        x.m_size -= n;
+    }
+}
+
+// 合并两条以 nullptr 结尾的有序单链 (只看 next)，a 中元素先于 b，相等时保持 a 在前
+template<class T, class Alloc>
+template <class Compare>
+typename list<T, Alloc>::link_type
+list<T, Alloc>::merge_chain(link_type a, link_type b, Compare& comp) {
+    link_type head = nullptr;
+    link_type* tail = &head;
+    while (a && b) {
+        if (comp(b->data, a->data)) {
+            *tail = b;
+            b = b->next;
+        }
+        else {
+            *tail = a;
+            a = a->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = a ? a : b;
+    return head;
+}
+
+template<class T, class Alloc>
+template <class Compare>
+void list<T, Alloc>::merge(list& x, Compare comp) {
+    if (this == &x) return;
+    link_type first1 = node->next;
+    link_type first2 = x.node->next;
+    while (first1 != node && first2 != x.node) {
+        if (comp(first2->data, first1->data)) {
+            // 把 x 中连续小于 *first1 的一段一次性移过来
+            link_type next2 = first2->next;
+            while (next2 != x.node && comp(next2->data, first1->data))
+                next2 = next2->next;
+            transfer(first1, first2, next2);
+            first2 = next2;
+        }
+        else {
+            first1 = first1->next;
+        }
+    }
+    if (first2 != x.node)
+        transfer(node, first2, x.node);
+    m_size += x.m_size;
+    x.m_size = 0;
+}
+
+template<class T, class Alloc>
+template <class Compare>
+void list<T, Alloc>::sort(Compare comp) {
+    if (m_size < 2) return;
+
+    // 断开成单链，bins[i] 存放长度为 2^i 的有序段
+    link_type head = node->next;
+    node->prev->next = nullptr;
+    link_type bins[64];
+    int fill = 0;
+    while (head) {
+        link_type carry = head;
+        head = head->next;
+        carry->next = nullptr;
+        int i = 0;
+        for (; i < fill && bins[i]; ++i) {
+            carry = merge_chain(bins[i], carry, comp);
+            bins[i] = nullptr;
+        }
+        bins[i] = carry;
+        if (i == fill) ++fill;
+    }
+    link_type result = nullptr;
+    for (int i = 0; i < fill; ++i) {
+        if (bins[i])
+            result = merge_chain(bins[i], result, comp);
+    }
+
+    // 重建 prev 指针并接回头节点
+    link_type prev = node;
+    for (link_type cur = result; cur; cur = cur->next) {
+        cur->prev = prev;
+        prev->next = cur;
+        prev = cur;
+    }
+    prev->next = node;
+    node->prev = prev;
+}
+
 
 
 
@@ -0,0 +1,154 @@
+#ifndef LOSER_TREE_H
+#define LOSER_TREE_H
+#include <assert.h>
+#include "vector.h"
+#include "iterator.h"
+#include "functional.h"
+#include "pair.h"
+namespace mystl {
+
+// 败者树 (tournament tree)：k 路中反复取最小者
+// 叶子 i 位于下标 k + i，内部节点 1 .. k-1 记录该处比赛的败者，m_tree[0] 为总冠军
+// 冠军的 key 更新后只需沿它到根的一条路径与各层败者比较，每次输出约 log k 次比较
+// 已耗尽的路视为 +∞；key 相等时下标小的路胜出，因此归并是稳定的
+template <class T, class Compare = mystl::less<T>>
+class loser_tree {
+public:
+    typedef T               value_type;
+    typedef const T&        const_reference;
+    typedef size_t          size_type;
+    typedef Compare         compare_type;
+
+public:
+    explicit loser_tree(size_type k, const compare_type& c = compare_type())
+        : m_keys(k), m_done(k, 1), m_tree(k == 0 ? 1 : k), m_k(k), cmp(c) {}
+
+    size_type ways() const { return m_k; }
+
+    // init 之前设置各路的初始 key，未设置的路视为已耗尽
+    void set(size_type i, const_reference x) {
+        m_keys.begin()[i] = x;
+        m_done.begin()[i] = 0;
+    }
+    void set_done(size_type i) { m_done.begin()[i] = 1; }
+    // 自底向上比赛一轮，O(k)
+    void init();
+
+    // 所有路都已耗尽
+    bool empty() const { return m_k == 0 || m_done[static_cast<int>(m_tree[0])]; }
+    // 冠军所在的路及其 key
+    size_type top() const { return m_tree[0]; }
+    const_reference top_key() const { return m_keys[static_cast<int>(m_tree[0])]; }
+
+    // 冠军所在路换成下一个 key
+    void replace_top(const_reference x) {
+        m_keys.begin()[m_tree[0]] = x;
+        replay(m_tree[0]);
+    }
+    // 冠军所在路耗尽
+    void pop_top() {
+        m_done.begin()[m_tree[0]] = 1;
+        replay(m_tree[0]);
+    }
+
+private:
+    // 路 a 是否应排在路 b 之前；相等时下标小者胜，只需一次 cmp
+    bool beats(size_type a, size_type b) {
+        const unsigned char* done = m_done.begin();
+        if (done[a] | done[b])
+            return done[a] ? done[b] && a < b : true;
+        // a < b 时 a 胜 <=> !cmp(b, a)，否则 a 胜 <=> cmp(a, b)；用选择代替分支
+        const bool a_first = a < b;
+        const size_type x = a_first ? b : a;
+        const size_type y = a ^ b ^ x;
+        const T* keys = m_keys.begin();
+        return a_first ^ cmp(keys[x], keys[y]);
+    }
+    // 叶子 i 的 key 变化后沿它到根的路径重赛
+    // 每层胜负随机，交换写成条件选择，编译器可生成 cmov，避免分支预测失败
+    void replay(size_type i) {
+        size_type* tree = m_tree.begin();
+        size_type winner = i;
+        for (size_type n = (m_k + i) / 2; n > 0; n /= 2) {
+            const size_type loser = tree[n];
+            const bool swap = beats(loser, winner);
+            tree[n] = swap ? winner : loser;
+            winner = swap ? loser : winner;
+        }
+        tree[0] = winner;
+    }
+
+private:
+    vector<T>               m_keys;     // 各路当前的 key
+    vector<unsigned char>   m_done;     // 各路是否已耗尽
+    vector<size_type>       m_tree;     // m_tree[0] 为冠军，m_tree[1 .. k-1] 为各场比赛的败者
+    size_type               m_k;
+    compare_type            cmp;
+};
+
+template <class T, class Compare>
+void loser_tree<T, Compare>::init() {
+    if (m_k == 0) return;
+    // winner[n] 为以 n 为根的子树的胜者，叶子的胜者就是自己
+    vector<size_type> winner(2 * m_k);
+    size_type* w = winner.begin();
+    size_type* tree = m_tree.begin();
+    for (size_type i = 0; i < m_k; ++i)
+        w[m_k + i] = i;
+    for (size_type n = m_k - 1; n > 0; --n) {
+        size_type l = w[2 * n], r = w[2 * n + 1];
+        if (beats(l, r)) {
+            w[n] = l;
+            tree[n] = r;
+        }
+        else {
+            w[n] = r;
+            tree[n] = l;
+        }
+    }
+    tree[0] = m_k == 1 ? 0 : w[1];
+}
+
+
+// k 路归并：[runs_first, runs_last) 中每个元素是一个 pair<Iter, Iter>，表示一段已按 cmp 有序的区间
+// 结果写入 out，相等元素按所在路的先后保持稳定；返回输出末尾
+template <class RunIter, class OutputIter, class Compare>
+OutputIter multiway_merge(RunIter runs_first, RunIter runs_last, OutputIter out, Compare cmp) {
+    typedef typename iterator_traits<RunIter>::value_type   run_type;
+    typedef typename run_type::first_type                   Iter;
+    typedef typename iterator_traits<Iter>::value_type      T;
+    typedef size_t                                          size_type;
+
+    const size_type k = static_cast<size_type>(mystl::distance(runs_first, runs_last));
+    vector<run_type> runs(k);
+    run_type* r = runs.begin();
+    loser_tree<T, Compare> tree(k, cmp);
+    for (size_type i = 0; i < k; ++i, ++runs_first) {
+        r[i] = *runs_first;
+        if (r[i].first != r[i].second)
+            tree.set(i, *r[i].first);
+    }
+    tree.init();
+
+    while (!tree.empty()) {
+        const size_type i = tree.top();
+        *out = tree.top_key();
+        ++out;
+        if (++r[i].first != r[i].second)
+            tree.replace_top(*r[i].first);
+        else
+            tree.pop_top();
+    }
+    return out;
+}
+
+template <class RunIter, class OutputIter>
+OutputIter multiway_merge(RunIter runs_first, RunIter runs_last, OutputIter out) {
+    typedef typename iterator_traits<RunIter>::value_type   run_type;
+    typedef typename run_type::first_type                   Iter;
+    typedef typename iterator_traits<Iter>::value_type      T;
+    return multiway_merge(runs_first, runs_last, out, mystl::less<T>());
+}
+
+}
+#endif
@@ -5,7 +5,8 @@
 
 namespace mystl {
 
-template <class Key, class Value, class Compare = less<Key>>
+// OrderStat 为 true 时支持按名次查询 (select / rank / count_range)
+template <class Key, class Value, class Compare = less<Key>, bool OrderStat = false>
 class map {
 public:
     typedef Key                                         key_type;   
@@ -13,7 +14,7 @@ public:
     typedef Compare                                     key_compare;
 private:
   // 以 mystl::rb_tree 作为底层机制
-    typedef mystl::rb_tree<Key, value_type, select1st<value_type>, key_compare>  base_type;
+    typedef mystl::rb_tree<Key, value_type, select1st<value_type>, key_compare, OrderStat>  base_type;
     base_type m_tree;
 
 public:
@@ -24,18 +25,146 @@ public:
     typedef typename base_type::reference               reference;
     typedef typename base_type::const_reference         const_reference;
     
+public:
+    map() {}
+    // 区间构造：排序去重后 O(n) 建树
+    template <class InputIter>
+    map(InputIter first, InputIter last) { m_tree.insert_unique(first, last); }
+
 public:
     pair<iterator, bool> insert(const value_type& val) { return m_tree.insert_unique(val); }
+    // 新键紧挨在 hint 之前时 O(1) 定位，有序输入可传 end()
+    iterator insert(iterator hint, const value_type& val) { return m_tree.insert_unique(hint, val); }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { m_tree.insert_unique(first, last); }
     iterator erase(const iterator& it) { return m_tree.erase(it); }
+    size_type erase(const key_type& key) { return m_tree.erase(key); }
 
     iterator begin() { return m_tree.begin(); }
     iterator end() { return m_tree.end(); }
 
     iterator find(const key_type& key) { return m_tree.find(key); }
+    size_type count(const key_type& key) { return m_tree.count(key); }
+    iterator lower_bound(const key_type& key) { return m_tree.lower_bound(key); }
+    iterator upper_bound(const key_type& key) { return m_tree.upper_bound(key); }
+    pair<iterator, iterator> equal_range(const key_type& key) { return m_tree.equal_range(key); }
+    // Compare 带 is_transparent 标记 (如 less<>) 时，可以直接用能与键比较的其他类型查找
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& k) { return m_tree.find(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& k) { return m_tree.count(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& k) { return m_tree.lower_bound(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& k) { return m_tree.upper_bound(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<iterator, iterator> equal_range(const K& k) { return m_tree.equal_range(k); }
+    // 对键落在 [lo, hi) 中的元素按顺序调用 f(value)
+    template <class Function>
+    Function for_each_in_range(const key_type& lo, const key_type& hi, Function f)
+    {
+        return m_tree.for_each_in_range(lo, hi, f);
+    }
     void for_each() { m_tree.for_each(m_tree.get_header()->parent); }
 
     size_type size() { return m_tree.size(); }
+
+    // 顺序统计，需要 OrderStat 为 true
+    iterator select(size_type k) { return m_tree.select(k); }
+    size_type rank(const key_type& key) { return m_tree.rank(key); }
+    size_type count_range(const key_type& lo, const key_type& hi) { return m_tree.count_range(lo, hi); }
+
+    // 基于 join 的批量操作，重用节点而不复制，参数中的另一个 map 操作后为空
+    // 键小于 k 的留下，其余移到 right
+    void split(const key_type& k, map& right) { m_tree.split(k, right.m_tree); }
+    // 要求本 map 的键 < x 的键 < right 的键
+    void join(const value_type& x, map& right) { m_tree.join(x, right.m_tree); }
+    // 要求本 map 的键都小于 right 的键
+    void join(map& right) { m_tree.join(right.m_tree); }
+    // 并 / 交 / 差，结果留在本 map 中，键重复时保留本 map 的元素
+    void set_union(map& other) { m_tree.set_union(other.m_tree); }
+    void set_intersection(map& other) { m_tree.set_intersection(other.m_tree); }
+    void set_difference(map& other) { m_tree.set_difference(other.m_tree); }
+    // 并行版本，pool 一般为 mystl::thread_pool (需包含 thread_pool.h)
+    template <class Pool>
+    void parallel_set_union(map& other, Pool& pool) { m_tree.parallel_set_union(other.m_tree, pool); }
+    // 与 insert(first, last) 结果相同，分块并行建树后并行合并
+    template <class RandomIter, class Pool>
+    void parallel_insert(RandomIter first, RandomIter last, Pool& pool)
+    {
+        m_tree.parallel_insert_unique(first, last, pool);
+    }
+};
+
+// 允许键重复的 map，等键值的元素按插入顺序排列
+// 用一个节点保存一对键值，不需要 map<K, vector<V>> 那样每个键再分配一个 vector
+template <class Key, class Value, class Compare = less<Key>, bool OrderStat = false>
+class multimap {
+public:
+    typedef Key                                         key_type;
+    typedef pair<key_type, Value>                       value_type;
+    typedef Compare                                     key_compare;
+private:
+    typedef mystl::rb_tree<Key, value_type, select1st<value_type>, key_compare, OrderStat>  base_type;
+    base_type m_tree;
+
+public:
+    typedef typename base_type::iterator                iterator;
+    typedef typename base_type::difference_type         difference_type;
+    typedef typename base_type::size_type               size_type;
+    typedef typename base_type::reference               reference;
+    typedef typename base_type::const_reference         const_reference;
+
+public:
+    multimap() {}
+    template <class InputIter>
+    multimap(InputIter first, InputIter last) { m_tree.insert_equal(first, last); }
+
+public:
+    iterator insert(const value_type& val) { return m_tree.insert_equal(val); }
+    // 有序输入可传 end()，新键不小于最大键时 O(1) 定位
+    iterator insert(iterator hint, const value_type& val) { return m_tree.insert_equal(hint, val); }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { m_tree.insert_equal(first, last); }
+    iterator erase(const iterator& it) { return m_tree.erase(it); }
+    void erase(iterator first, iterator last) { m_tree.erase(first, last); }
+    // 删除键等于 key 的所有元素，返回删除的个数
+    size_type erase(const key_type& key) { return m_tree.erase(key); }
+    void clear() { m_tree.clear(); }
+
+    iterator begin() { return m_tree.begin(); }
+    iterator end() { return m_tree.end(); }
+
+    // 返回等键值元素中的第一个
+    iterator find(const key_type& key) { return m_tree.find(key); }
+    size_type count(const key_type& key) { return m_tree.count(key); }
+    iterator lower_bound(const key_type& key) { return m_tree.lower_bound(key); }
+    iterator upper_bound(const key_type& key) { return m_tree.upper_bound(key); }
+    pair<iterator, iterator> equal_range(const key_type& key) { return m_tree.equal_range(key); }
+    // Compare 带 is_transparent 标记 (如 less<>) 时，可以直接用能与键比较的其他类型查找
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& k) { return m_tree.find(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& k) { return m_tree.count(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& k) { return m_tree.lower_bound(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& k) { return m_tree.upper_bound(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<iterator, iterator> equal_range(const K& k) { return m_tree.equal_range(k); }
+    template <class Function>
+    Function for_each_in_range(const key_type& lo, const key_type& hi, Function f)
+    {
+        return m_tree.for_each_in_range(lo, hi, f);
+    }
+
+    size_type size() { return m_tree.size(); }
+
+    // 顺序统计，需要 OrderStat 为 true
+    iterator select(size_type k) { return m_tree.select(k); }
+    size_type rank(const key_type& key) { return m_tree.rank(key); }
+    size_type count_range(const key_type& lo, const key_type& hi) { return m_tree.count_range(lo, hi); }
 };
 }
 
-#endif  
\ No newline at end of file
+#endif
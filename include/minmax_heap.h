@@ -0,0 +1,196 @@
+#ifndef MINMAX_HEAP_H
+#define MINMAX_HEAP_H
+#include <assert.h>
+#include "vector.h"
+#include "functional.h"
+#include "util.h"
+namespace mystl {
+
+// min-max heap (Atkinson 等)：双端优先队列
+// 下标从 0 开始的完全二叉树，偶数层 (根为第 0 层) 为 min 层、奇数层为 max 层：
+// min 层节点不大于其所有子孙，max 层节点不小于其所有子孙
+// 最小值在根，最大值在根的两个孩子之一，push / pop_min / pop_max 为 O(log n)
+template <class T, class Container = vector<T>, class Compare = mystl::less<T>>
+class minmax_heap {
+public:
+    typedef Container                           container_type;
+    typedef Compare                             compare_type;
+    typedef typename Container::value_type      value_type;
+    typedef typename Container::size_type       size_type;
+    typedef typename Container::reference       reference;
+    typedef typename Container::const_reference const_reference;
+
+public:
+    size_type size() { return c.size(); }
+    bool empty() { return size() == 0; }
+
+    reference min() { assert(size() > 0); return c[0]; }
+    reference max() { assert(size() > 0); return c[static_cast<int>(max_index())]; }
+
+    void push(const_reference x);
+    void pop_min();
+    void pop_max();
+    // 等价于 pop_min 后 push(x)，但只下沉一次 (top-K 淘汰最小值时使用)
+    void replace_min(const_reference x);
+    // 等价于 pop_max 后 push(x)
+    void replace_max(const_reference x);
+
+    container_type c;
+
+private:
+    // 第 i 个节点是否在 min 层：层号为 floor(log2(i + 1))
+    static bool is_min_level(size_type i) {
+#if defined(__GNUC__) || defined(__clang__)
+        return (__builtin_clzll(static_cast<unsigned long long>(i + 1)) & 1) ==
+               ((sizeof(unsigned long long) * 8 - 1) & 1);
+#else
+        int level = 0;
+        for (++i; i > 1; i >>= 1) ++level;
+        return (level & 1) == 0;
+#endif
+    }
+    size_type max_index() {
+        const size_type n = c.size();
+        if (n < 3) return n - 1;
+        return cmp(c.begin()[1], c.begin()[2]) ? 2 : 1;
+    }
+
+    // Less 为 true 时沿 min 层处理，否则沿 max 层处理 (比较方向取反)
+    template <bool Less>
+    bool before(const T& a, const T& b) { return Less ? cmp(a, b) : cmp(b, a); }
+    // hole 与 value 同在 Less 对应的层上，隔层向上浮动
+    template <bool Less>
+    void bubble_up(size_type hole, T value);
+    // hole 在 Less 对应的层上，把 value 向下放到合适位置
+    template <bool Less>
+    void trickle_down(size_type hole, T value);
+    // 删除 hole 处的元素，用末尾元素填补
+    template <bool Less>
+    void erase_at(size_type hole);
+
+private:
+    compare_type cmp;
+};
+
+template <class T, class Container, class Compare>
+template <bool Less>
+void minmax_heap<T, Container, Compare>::bubble_up(size_type hole, T value) {
+    T* d = c.begin();
+    while (hole > 2) {
+        const size_type grand = ((hole - 1) / 2 - 1) / 2;
+        if (!before<Less>(value, d[grand])) break;
+        d[hole] = mystl::move(d[grand]);
+        hole = grand;
+    }
+    d[hole] = mystl::move(value);
+}
+
+template <class T, class Container, class Compare>
+void minmax_heap<T, Container, Compare>::push(const_reference x) {
+    c.push_back(x);
+    size_type hole = c.size() - 1;
+    if (hole == 0) return;
+    T value = mystl::move(c.begin()[hole]);
+    T* d = c.begin();
+    const size_type parent = (hole - 1) / 2;
+    if (is_min_level(hole)) {
+        // 父节点在 max 层：比父节点大就换到 max 层继续上浮
+        if (cmp(d[parent], value)) {
+            d[hole] = mystl::move(d[parent]);
+            bubble_up<false>(parent, mystl::move(value));
+        }
+        else {
+            bubble_up<true>(hole, mystl::move(value));
+        }
+    }
+    else {
+        if (cmp(value, d[parent])) {
+            d[hole] = mystl::move(d[parent]);
+            bubble_up<true>(parent, mystl::move(value));
+        }
+        else {
+            bubble_up<false>(hole, mystl::move(value));
+        }
+    }
+}
+
+template <class T, class Container, class Compare>
+template <bool Less>
+void minmax_heap<T, Container, Compare>::trickle_down(size_type hole, T value) {
+    T* d = c.begin();
+    const size_type len = c.size();
+    while (true) {
+        const size_type child = 2 * hole + 1;
+        if (child >= len) break;
+        // 在至多 2 个孩子和 4 个孙子中找最优者
+        size_type best = child;
+        if (child + 1 < len && before<Less>(d[child + 1], d[best])) best = child + 1;
+        const size_type grand = 2 * child + 1;
+        const size_type grand_last = grand + 4 < len ? grand + 4 : len;
+        for (size_type g = grand; g < grand_last; ++g) {
+            if (before<Less>(d[g], d[best])) best = g;
+        }
+        if (!before<Less>(d[best], value)) break;
+        d[hole] = mystl::move(d[best]);
+        hole = best;
+        if (best < grand) break;  // 最优者是孩子，其下没有孙子层需要处理
+        // 最优者是孙子：与其父 (相反层) 比较，必要时交换后继续下沉
+        const size_type parent = (best - 1) / 2;
+        if (before<Less>(d[parent], value)) {
+            T temp = mystl::move(d[parent]);
+            d[parent] = mystl::move(value);
+            value = mystl::move(temp);
+        }
+    }
+    d[hole] = mystl::move(value);
+}
+
+template <class T, class Container, class Compare>
+template <bool Less>
+void minmax_heap<T, Container, Compare>::erase_at(size_type hole) {
+    T value = mystl::move(c.back());
+    c.pop_back();
+    if (hole < c.size())
+        trickle_down<Less>(hole, mystl::move(value));
+}
+
+template <class T, class Container, class Compare>
+void minmax_heap<T, Container, Compare>::pop_min() {
+    assert(size() > 0);
+    erase_at<true>(0);
+}
+
+template <class T, class Container, class Compare>
+void minmax_heap<T, Container, Compare>::pop_max() {
+    assert(size() > 0);
+    erase_at<false>(max_index());
+}
+
+template <class T, class Container, class Compare>
+void minmax_heap<T, Container, Compare>::replace_min(const_reference x) {
+    assert(size() > 0);
+    // 根没有父节点，x 比某个 max 层节点大时会在下沉过程中与之交换
+    trickle_down<true>(0, x);
+}
+
+template <class T, class Container, class Compare>
+void minmax_heap<T, Container, Compare>::replace_max(const_reference x) {
+    assert(size() > 0);
+    const size_type hole = max_index();
+    if (hole == 0) {
+        c.begin()[0] = x;
+        return;
+    }
+    // max 节点之上还有根：x 比最小值还小时先与根交换
+    T value = x;
+    T* d = c.begin();
+    if (cmp(value, d[0])) {
+        T temp = mystl::move(d[0]);
+        d[0] = mystl::move(value);
+        value = mystl::move(temp);
+    }
+    trickle_down<false>(hole, mystl::move(value));
+}
+
+}
+#endif
@@ -0,0 +1,131 @@
+#ifndef MULTI_QUEUE_H
+#define MULTI_QUEUE_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "queue.h"
+#include "random.h"
+namespace mystl {
+
+// MultiQueue：松弛的并发优先队列
+// 内部有 c * P 个各自带锁的堆 (heap.h 上的 priority_queue)；push 放入随机一个堆，
+// pop 随机取两个堆比较堆顶，弹出较优者。不保证严格的全局顺序，
+// 但弹出元素的期望排名误差为 O(c * P)，换来的是锁几乎不冲突
+template <class T, class Compare = mystl::less<T>, size_t D = 4>
+class multi_queue {
+    typedef priority_queue<T, vector<T>, Compare, D>    heap_type;
+
+    struct alignas(64) shard {
+        std::mutex              lock;
+        heap_type               heap;
+        std::atomic<size_t>     count;  // 锁外读取，用于快速跳过空堆
+
+        shard() : count(0) {}
+    };
+
+public:
+    typedef T               value_type;
+    typedef const T&        const_reference;
+    typedef size_t          size_type;
+    typedef Compare         compare_type;
+
+public:
+    explicit multi_queue(size_type threads = std::thread::hardware_concurrency(), size_type c = 2)
+        : m_nshards((threads == 0 ? 1 : threads) * (c == 0 ? 1 : c)) {
+        if (m_nshards < 2) m_nshards = 2;
+        m_shards = new shard[m_nshards];
+    }
+    ~multi_queue() { delete[] m_shards; }
+    multi_queue(const multi_queue&) = delete;
+    multi_queue& operator= (const multi_queue&) = delete;
+
+    // 近似值
+    size_type size() const {
+        size_type n = 0;
+        for (size_type i = 0; i < m_nshards; ++i)
+            n += m_shards[i].count.load(std::memory_order_relaxed);
+        return n;
+    }
+    bool empty() const { return size() == 0; }
+    size_type shard_count() const { return m_nshards; }
+
+    void push(const_reference x);
+    // 队列为空时返回 false
+    bool try_pop(T& out);
+
+private:
+    shard& random_shard() { return m_shards[thread_rand()(static_cast<uint32_t>(m_nshards))]; }
+    // 在已加锁的 s 上弹出堆顶
+    static void pop_locked(shard& s, T& out) {
+        out = s.heap.top();
+        s.heap.pop();
+        s.count.store(s.heap.size(), std::memory_order_relaxed);
+    }
+    // 两个随机堆都取不到时，逐个加锁扫描，确认是否真的为空
+    bool pop_scan(T& out);
+
+private:
+    shard*      m_shards;
+    size_type   m_nshards;
+    Compare     cmp;
+};
+
+template <class T, class Compare, size_t D>
+void multi_queue<T, Compare, D>::push(const_reference x) {
+    while (true) {
+        shard& s = random_shard();
+        if (!s.lock.try_lock()) continue;
+        s.heap.push(x);
+        s.count.store(s.heap.size(), std::memory_order_relaxed);
+        s.lock.unlock();
+        return;
+    }
+}
+
+template <class T, class Compare, size_t D>
+bool multi_queue<T, Compare, D>::try_pop(T& out) {
+    for (size_type attempt = 0; attempt < 2 * m_nshards; ++attempt) {
+        shard* a = &random_shard();
+        shard* b = &random_shard();
+        if (a == b) continue;
+        if (a->count.load(std::memory_order_relaxed) == 0 &&
+            b->count.load(std::memory_order_relaxed) == 0)
+            continue;
+        if (!a->lock.try_lock()) continue;
+        if (!b->lock.try_lock()) {
+            a->lock.unlock();
+            continue;
+        }
+        shard* best = nullptr;
+        if (a->heap.empty())
+            best = b->heap.empty() ? nullptr : b;
+        else if (b->heap.empty())
+            best = a;
+        else
+            best = cmp(a->heap.top(), b->heap.top()) ? b : a;
+        if (best)
+            pop_locked(*best, out);
+        b->lock.unlock();
+        a->lock.unlock();
+        if (best) return true;
+    }
+    return pop_scan(out);
+}
+
+template <class T, class Compare, size_t D>
+bool multi_queue<T, Compare, D>::pop_scan(T& out) {
+    const size_type start = thread_rand()(static_cast<uint32_t>(m_nshards));
+    for (size_type i = 0; i < m_nshards; ++i) {
+        shard& s = m_shards[(start + i) % m_nshards];
+        std::lock_guard<std::mutex> guard(s.lock);
+        if (!s.heap.empty()) {
+            pop_locked(s, out);
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+#endif
@@ -0,0 +1,219 @@
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+#include <assert.h>
+#include "allocator.h"
+#include "construct.h"
+#include "functional.h"
+namespace mystl {
+
+// 左孩子右兄弟表示；prev 对最左孩子指向父节点，否则指向左兄弟，根为 nullptr
+template <class T>
+struct __pairing_heap_node {
+    typedef __pairing_heap_node*    link_type;
+    link_type   child;
+    link_type   sibling;
+    link_type   prev;
+    T           value;
+};
+
+// pairing heap：可合并的优先队列
+// push / meld / top 为 O(1)，pop 均摊 O(log n)；push 返回节点指针作为 handle，
+// 节点在被弹出或删除前地址不变，可据此修改优先级或删除
+// Compare 语义与 priority_queue 一致，默认 less 为大顶堆
+template <class T, class Compare = mystl::less<T>>
+class pairing_heap {
+public:
+    typedef T                           value_type;
+    typedef T&                          reference;
+    typedef const T&                    const_reference;
+    typedef size_t                      size_type;
+    typedef Compare                     compare_type;
+
+    typedef __pairing_heap_node<T>      heap_node;
+    typedef heap_node*                  link_type;
+    typedef link_type                   handle_type;
+    typedef alloc<heap_node>            node_allocator;
+
+public:
+    pairing_heap() : m_root(nullptr), m_size(0) {}
+    ~pairing_heap() { clear(); }
+    pairing_heap(const pairing_heap&) = delete;
+    pairing_heap& operator= (const pairing_heap&) = delete;
+
+    size_type size() const { return m_size; }
+    bool empty() const { return m_root == nullptr; }
+
+    handle_type push(const_reference x);
+    reference top() { assert(!empty()); return m_root->value; }
+    handle_type top_handle() { assert(!empty()); return m_root; }
+    void pop();
+    void clear();
+
+    const_reference get(handle_type h) const { return h->value; }
+
+    // 把 rhs 的全部元素并入本堆，O(1)；rhs 变为空，其 handle 此后属于本堆
+    void meld(pairing_heap& rhs);
+    // 把 h 的元素改为优先级不低于原值的 x (向堆顶方向，对小顶堆即 decrease-key)，均摊 O(1)
+    void decrease_key(handle_type h, const_reference x);
+    // 按 handle 删除，均摊 O(log n)
+    void erase(handle_type h);
+
+private:
+    link_type create_node(const_reference x) {
+        link_type n = node_allocator::allocate();
+        construct(&n->value, x);
+        n->child = n->sibling = n->prev = nullptr;
+        return n;
+    }
+    void destroy_node(link_type n) {
+        destory(&n->value);
+        node_allocator::deallocate(n);
+    }
+
+    // 合并两棵树，返回新根；忽略 a、b 原有的 sibling / prev
+    link_type link(link_type a, link_type b);
+    // 把 n 连同其子树从所在的孩子链表中摘下
+    static void cut(link_type n);
+    // 两趟合并孩子链表：先从左到右两两合并，再从右到左依次并入
+    link_type merge_pairs(link_type first);
+
+private:
+    link_type   m_root;
+    size_type   m_size;
+    compare_type cmp;
+};
+
+template <class T, class Compare>
+typename pairing_heap<T, Compare>::link_type
+pairing_heap<T, Compare>::link(link_type a, link_type b) {
+    if (cmp(a->value, b->value)) {
+        link_type temp = a;
+        a = b;
+        b = temp;
+    }
+    // a 为胜者，b 成为 a 的最左孩子
+    b->prev = a;
+    b->sibling = a->child;
+    if (a->child) a->child->prev = b;
+    a->child = b;
+    a->sibling = nullptr;
+    a->prev = nullptr;
+    return a;
+}
+
+template <class T, class Compare>
+void pairing_heap<T, Compare>::cut(link_type n) {
+    if (n->prev->child == n)
+        n->prev->child = n->sibling;
+    else
+        n->prev->sibling = n->sibling;
+    if (n->sibling) n->sibling->prev = n->prev;
+    n->sibling = nullptr;
+    n->prev = nullptr;
+}
+
+template <class T, class Compare>
+typename pairing_heap<T, Compare>::link_type
+pairing_heap<T, Compare>::merge_pairs(link_type first) {
+    if (!first) return nullptr;
+    // 第一趟：两两合并，结果借 sibling 串成逆序链表
+    link_type head = nullptr;
+    while (first) {
+        link_type a = first;
+        link_type b = first->sibling;
+        if (!b) {
+            a->sibling = head;
+            head = a;
+            break;
+        }
+        first = b->sibling;
+        a = link(a, b);
+        a->sibling = head;
+        head = a;
+    }
+    // 第二趟：从最右一对开始依次并入
+    link_type root = head;
+    head = head->sibling;
+    while (head) {
+        link_type next = head->sibling;
+        root = link(root, head);
+        head = next;
+    }
+    root->sibling = nullptr;
+    root->prev = nullptr;
+    return root;
+}
+
+template <class T, class Compare>
+typename pairing_heap<T, Compare>::handle_type
+pairing_heap<T, Compare>::push(const_reference x) {
+    link_type n = create_node(x);
+    m_root = m_root ? link(m_root, n) : n;
+    ++m_size;
+    return n;
+}
+
+template <class T, class Compare>
+void pairing_heap<T, Compare>::pop() {
+    assert(!empty());
+    link_type old = m_root;
+    m_root = merge_pairs(old->child);
+    destroy_node(old);
+    --m_size;
+}
+
+template <class T, class Compare>
+void pairing_heap<T, Compare>::meld(pairing_heap& rhs) {
+    if (this == &rhs || rhs.empty()) return;
+    m_root = m_root ? link(m_root, rhs.m_root) : rhs.m_root;
+    m_size += rhs.m_size;
+    rhs.m_root = nullptr;
+    rhs.m_size = 0;
+}
+
+template <class T, class Compare>
+void pairing_heap<T, Compare>::decrease_key(handle_type h, const_reference x) {
+    assert(!cmp(x, h->value));
+    h->value = x;
+    if (h == m_root) return;
+    cut(h);
+    m_root = link(m_root, h);
+}
+
+template <class T, class Compare>
+void pairing_heap<T, Compare>::erase(handle_type h) {
+    if (h == m_root) {
+        pop();
+        return;
+    }
+    cut(h);
+    link_type sub = merge_pairs(h->child);
+    destroy_node(h);
+    --m_size;
+    if (sub) m_root = link(m_root, sub);
+}
+
+// 把 child / sibling 看作二叉树的左右孩子，不断右旋把左孩子转到右侧，
+// 左孩子为空时释放当前节点并沿右链前进；不递归、不需要额外空间
+template <class T, class Compare>
+void pairing_heap<T, Compare>::clear() {
+    link_type p = m_root;
+    while (p) {
+        if (p->child) {
+            link_type c = p->child;
+            p->child = c->sibling;
+            c->sibling = p;
+            p = c;
+        }
+        else {
+            link_type next = p->sibling;
+            destroy_node(p);
+            p = next;
+        }
+    }
+    m_root = nullptr;
+    m_size = 0;
+}
+
+}
+#endif
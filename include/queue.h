@@ -5,6 +5,7 @@
 #include "heap.h"
 #include "algo.h"
 #include "functional.h"
+#include <type_traits>
 namespace mystl {
 
 template <class T, class Container = deque<T>>
@@ -32,7 +33,8 @@ private:
 
 
 
-template <class T, class Container = vector<int>, class Compare = mystl::less<T>>
+// 默认 4 叉堆：层数减半，同一组孩子落在相邻的 cache line 上
+template <class T, class Container = vector<T>, class Compare = mystl::less<T>, size_t D = 4>
 class priority_queue {
 public:
     typedef Container                           container_type;
@@ -43,34 +45,67 @@ public:
     typedef typename Container::reference       reference;
     typedef typename Container::const_reference const_reference;
 
+    static constexpr size_t arity = D;
+
 public:
-    priority_queue(size_type n = 0) : c(n + 1) {} 
-    priority_queue(size_type n, const_reference value) : c(n + 1, value) {}
+    priority_queue(size_type n = 0) : c(n) {} 
+    priority_queue(size_type n, const_reference value) : c(n, value) {}
+    // 复制区间后 O(n) 建堆
+    template <class Iterator, class = typename std::enable_if<!std::is_integral<Iterator>::value>::type>
+    priority_queue(Iterator first, Iterator last) : c() {
+        for (; first != last; ++first)
+            c.push_back(*first);
+        make_heap<D>(c.begin(), c.end(), cmp);
+    }
 
 public:
-    size_type size() { return c.size() - 1; }
+    size_type size() { return c.size(); }
     bool empty() { return size() == 0; }
 
     void push(const_reference x) {
         c.push_back(x); 
-        push_heap(c.begin(), c.end(), x, cmp);
+        push_heap<D>(c.begin(), c.end(), cmp);
     }
+    // 批量压入：新元素先追加到尾部，批量相对堆较大时整体重建 (O(n + k))，
+    // 否则逐个上浮 (O(k log n))
+    template <class Iterator>
+    void push_range(Iterator first, Iterator last);
+
     void pop() { 
         assert(size() > 0);
-        const_reference value = c.back();
-        top() = c.back();
+        pop_heap<D>(c.begin(), c.end(), cmp);
         c.pop_back(); 
-
-        pop_heap(c.begin(), c.end(), value, cmp);  
     }
 
-    reference top() { assert(size() > 0); return c[1]; }
+    reference top() { assert(size() > 0); return c[0]; }
 
     container_type c;
 private:
     compare_type cmp;
 };
 
+template <class T, class Container, class Compare, size_t D>
+template <class Iterator>
+void priority_queue<T, Container, Compare, D>::push_range(Iterator first, Iterator last) {
+    const size_type old_size = c.size();
+    for (; first != last; ++first)
+        c.push_back(*first);
+    const size_type total = c.size();
+    const size_type k = total - old_size;
+    if (k == 0) return;
+
+    // 逐个上浮每个元素约 log_D(total) 层
+    size_type depth = 1;
+    for (size_type n = total; n >= D; n /= D) ++depth;
+    if (k * depth >= total) {
+        make_heap<D>(c.begin(), c.end(), cmp);
+    }
+    else {
+        for (size_type i = old_size; i < total; ++i)
+            push_heap<D>(c.begin(), c.begin() + i + 1, cmp);
+    }
+}
+
 
 
 }
@@ -0,0 +1,97 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+#include <assert.h>
+#include <type_traits>
+#include "vector.h"
+#include "functional.h"
+namespace mystl {
+
+// 无符号整数 key 的二进制位宽：x 为 0 时返回 0，否则为最高位 1 的位置 + 1
+template <class Key>
+inline int radix_bit_width(Key x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return x == 0 ? 0 : static_cast<int>(sizeof(unsigned long long) * 8) -
+                        __builtin_clzll(static_cast<unsigned long long>(x));
+#else
+    int n = 0;
+    while (x) { x >>= 1; ++n; }
+    return n;
+#endif
+}
+
+// radix heap：单调优先队列，弹出的最小 key 不减 (定时器、Dijkstra 等场景)
+// 第 i 个桶存放与上次弹出 key (m_last) 的最高不同位为 i-1 的元素，桶 0 存放等于 m_last 的元素
+// 桶 0 空时把第一个非空桶按新的最小值重新分配到更低的桶，每个元素最多下移 O(log C) 次
+// key 通过 KeyOfValue 取得，与 rb_tree 相同；接口与 priority_queue 一致 (top 为最小值)
+template <class T, class KeyOfValue = identity<T>>
+class radix_heap {
+public:
+    typedef T                   value_type;
+    typedef T&                  reference;
+    typedef const T&            const_reference;
+    typedef size_t              size_type;
+    typedef typename std::decay<decltype(KeyOfValue()(std::declval<const T&>()))>::type key_type;
+
+    static_assert(std::is_integral<key_type>::value && std::is_unsigned<key_type>::value,
+                  "radix_heap requires an unsigned integral key");
+
+    static constexpr int bucket_count = static_cast<int>(sizeof(key_type) * 8) + 1;
+
+public:
+    radix_heap() : m_last(0), m_size(0) {}
+
+    size_type size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    // 要求 key(x) 不小于最近一次弹出的 key
+    void push(const_reference x) {
+        const key_type k = key(x);
+        assert(k >= m_last);
+        m_buckets[radix_bit_width(k ^ m_last)].push_back(x);
+        ++m_size;
+    }
+
+    reference top() {
+        assert(!empty());
+        pull();
+        return m_buckets[0].back();
+    }
+
+    void pop() {
+        assert(!empty());
+        pull();
+        m_buckets[0].pop_back();
+        --m_size;
+    }
+
+    // 最近一次弹出 (或当前堆顶) 的 key，新 push 的 key 不能小于它
+    key_type last_key() const { return m_last; }
+
+private:
+    key_type key(const_reference x) const { return KeyOfValue()(x); }
+
+    // 保证桶 0 非空
+    void pull() {
+        if (!m_buckets[0].empty()) return;
+        int i = 1;
+        while (m_buckets[i].empty()) ++i;
+
+        vector<T>& b = m_buckets[i];
+        key_type new_last = key(b.front());
+        for (auto it = b.begin(); it != b.end(); ++it) {
+            if (key(*it) < new_last) new_last = key(*it);
+        }
+        m_last = new_last;
+        for (auto it = b.begin(); it != b.end(); ++it)
+            m_buckets[radix_bit_width(key(*it) ^ m_last)].push_back(mystl::move(*it));
+        b.clear();
+    }
+
+private:
+    vector<T>   m_buckets[bucket_count];
+    key_type    m_last;
+    size_type   m_size;
+};
+
+}
+#endif
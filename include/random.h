@@ -0,0 +1,36 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+namespace mystl {
+
+// xorshift32 伪随机数，供调度器挑选 victim / 随机堆使用
+// 不追求统计质量，只要求快且每个线程一份状态
+struct xorshift32 {
+    uint32_t state;
+
+    explicit xorshift32(uint32_t seed = 2463534242u) : state(seed ? seed : 2463534242u) {}
+
+    uint32_t operator() () {
+        uint32_t x = state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return state = x;
+    }
+
+    // [0, n)
+    uint32_t operator() (uint32_t n) {
+        return static_cast<uint32_t>((static_cast<uint64_t>((*this)()) * n) >> 32);
+    }
+};
+
+// 每个线程独立的随机数发生器，种子取自线程局部变量的地址
+inline xorshift32& thread_rand() {
+    static thread_local xorshift32 rng(
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&rng) >> 4));
+    return rng;
+}
+
+}
+#endif
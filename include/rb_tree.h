@@ -7,6 +7,8 @@
 #include "algo.h"
 #include "pair.h"
 #include "functional.h" 
+#include "vector.h"
+#include <type_traits>
 
 namespace mystl {
 
@@ -19,14 +21,14 @@ static constexpr rb_tree_color_type rb_tree_black = true;
 
 
 // forward declaration
-template <class T> struct rb_tree_node;
-template <class T> struct rb_tree_iterator;
+template <class T, bool OrderStat = false> struct rb_tree_node;
+template <class T, bool OrderStat = false> struct rb_tree_iterator;
 
-template <class T> 
+template <class T, bool OrderStat> 
 struct rb_tree_iterator : public iterator<bidirectional_iterator_tag, T> {
     typedef rb_tree_iterator                            self;
     typedef self                                        iterator;
-    typedef rb_tree_node<T>*                            link_type;
+    typedef rb_tree_node<T, OrderStat>*                 link_type;
 
     typedef typename self::iterator_category            iterator_category;
     typedef typename self::value_type                   value_type;
@@ -39,7 +41,6 @@ struct rb_tree_iterator : public iterator<bidirectional_iterator_tag, T> {
       // 构造函数
     rb_tree_iterator() {}
     rb_tree_iterator(link_type x) : node(x) {}
-    rb_tree_iterator(const iterator& rhs) { node = rhs.node; }
     
 
       // 重载操作符
@@ -108,9 +109,23 @@ struct rb_tree_iterator : public iterator<bidirectional_iterator_tag, T> {
 };
 
 
-template <class T>
+template <class T, bool OrderStat>
 struct rb_tree_node {
-    typedef rb_tree_node<T>*    link_type;
+    typedef rb_tree_node<T, OrderStat>*    link_type;
+    typedef rb_tree_color_type    color_type;
+    
+    
+    link_type left;
+    link_type right;
+    link_type parent;
+    color_type  color;
+    T value;
+};
+
+// 顺序统计版本：size 为以该节点为根的子树的节点数
+template <class T>
+struct rb_tree_node<T, true> {
+    typedef rb_tree_node<T, true>*    link_type;
     typedef rb_tree_color_type    color_type;
     
     
@@ -118,9 +133,86 @@ struct rb_tree_node {
     link_type right;
     link_type parent;
     color_type  color;
+    size_t size;
     T value;
 };
 
+// 子树大小的维护，普通节点上全部为空操作
+
+template <class T>
+size_t rb_tree_size(rb_tree_node<T, true>* x) noexcept
+{
+  return x == nullptr ? 0 : x->size;
+}
+
+// 由左右孩子重新计算 x 的子树大小
+template <class T>
+void rb_tree_size_fix(rb_tree_node<T, false>*) noexcept {}
+
+template <class T>
+void rb_tree_size_fix(rb_tree_node<T, true>* x) noexcept
+{
+  x->size = 1 + rb_tree_size(x->left) + rb_tree_size(x->right);
+}
+
+// 旋转后 y 取代 x 成为子树根：y 接过原子树大小，x 重新计算
+template <class T>
+void rb_tree_size_rotate(rb_tree_node<T, false>*, rb_tree_node<T, false>*) noexcept {}
+
+template <class T>
+void rb_tree_size_rotate(rb_tree_node<T, true>* x, rb_tree_node<T, true>* y) noexcept
+{
+  y->size = x->size;
+  rb_tree_size_fix(x);
+}
+
+// x 到 root 路径上的每个节点 (含两端) 子树大小加 delta
+template <class T>
+void rb_tree_size_path_add(rb_tree_node<T, false>*, rb_tree_node<T, false>*, int) noexcept {}
+
+template <class T>
+void rb_tree_size_path_add(rb_tree_node<T, true>* x, rb_tree_node<T, true>* root, int delta) noexcept
+{
+  while (true)
+  {
+    x->size += delta;
+    if (x == root) break;
+    x = x->parent;
+  }
+}
+
+// split 之后左半部分的节点数：顺序统计版本直接读子树大小
+template <class T>
+size_t rb_tree_split_count(rb_tree_node<T, true>* left, rb_tree_node<T, true>*, size_t) noexcept
+{
+  return rb_tree_size(left);
+}
+
+// 普通版本：两棵子树同时遍历，先遍历完的一棵给出准确个数，代价 O(min(|left|, |right|))
+// 红黑树高度不超过 2log(n + 1)，先序遍历的栈深度不超过高度加一
+template <class T>
+size_t rb_tree_split_count(rb_tree_node<T, false>* left, rb_tree_node<T, false>* right, size_t total) noexcept
+{
+  typedef rb_tree_node<T, false>* link_type;
+  link_type sl[160], sr[160];
+  int tl = 0, tr = 0;
+  size_t nl = 0, nr = 0;
+  if (left != nullptr) sl[tl++] = left;
+  if (right != nullptr) sr[tr++] = right;
+  while (tl > 0 && tr > 0)
+  {
+    link_type x = sl[--tl];
+    ++nl;
+    if (x->right != nullptr) sl[tl++] = x->right;
+    if (x->left != nullptr) sl[tl++] = x->left;
+    link_type y = sr[--tr];
+    ++nr;
+    if (y->right != nullptr) sr[tr++] = y->right;
+    if (y->left != nullptr) sr[tr++] = y->left;
+  }
+  return tl == 0 ? nl : total - nr;
+}
+
 // tree algorithm
 
 template <class NodePtr>
@@ -169,7 +261,11 @@ NodePtr rb_tree_next(NodePtr node) noexcept
   if (node->right != nullptr)
     return rb_tree_min(node->right);
   while (!rb_tree_is_lchild(node))
+  {
+    if (node->parent->parent == node)  // 从最大节点一路回到根，下一个是 header
+      return node->parent;
     node = node->parent;
+  }
   return node->parent;
 }
 
@@ -267,6 +363,7 @@ void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept
   // 调整 x 与 y 的关系
   y->right = x;                      
   x->parent = y;
+  rb_tree_size_rotate(x, y);
 }
 
 
@@ -304,6 +401,7 @@ void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept
   // 调整 x 与 y 的关系
   y->left = x;  
   x->parent = y;
+  rb_tree_size_rotate(x, y);
 }
 
 
@@ -316,6 +414,9 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
   auto x = y->left != nullptr ? y->left : y->right;
   // xp 为 x 的父节点
   NodePtr xp = nullptr;
+  // y 将从原位置摘下：其上方直到根的子树大小各减一 (y 为根时无需处理)
+  if (y != root)
+    rb_tree_size_path_add(y->parent, root, -1);
 
   // y != z 说明 z 有两个非空子节点，此时 y 指向 z 右子树的最左节点，x 指向 y 的右子节点。
   // 用 y 顶替 z 的位置，用 x 顶替 y 的位置，最后用 y 指向 z
@@ -348,6 +449,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
     else
       z->parent->right = y;
     y->parent = z->parent;
+    rb_tree_size_rotate(z, y);
     // mystl::swap(y->color, z->color);
 
     rb_tree_color_type t = y->color;
@@ -473,14 +575,15 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
 
 
 
-template <class Key, class Value, class KeyOfValue, class Compare> 
+// OrderStat 为 true 时每个节点额外记录子树大小，支持 O(log n) 的 select / rank / count_range
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat = false>
 class rb_tree {
 public:
   // rb_tree 的嵌套型别定义 
-    typedef rb_tree_iterator<Value>                 iterator;
+    typedef rb_tree_iterator<Value, OrderStat>      iterator;
     typedef typename iterator::link_type            link_type;
 
-    typedef mystl::alloc<rb_tree_node<Value> >      node_allocator;
+    typedef mystl::alloc<rb_tree_node<Value, OrderStat> >   node_allocator;
     typedef mystl::alloc<Value>                     data_allocator;
 
     typedef typename iterator::pointer              pointer;
@@ -504,7 +607,8 @@ private:
     link_type& root()      const { return m_header->parent; }
     link_type& leftmost()  const { return m_header->left; }
     link_type& rightmost() const { return m_header->right; }
-    key_type key(const value_type& val) const { return KeyOfValue()(val); }  
+    // 直接引用节点中的键，比较时不复制 (string 之类的键每层都会分配一次内存)
+    const key_type& key(const value_type& val) const { return KeyOfValue()(val); }
 
 public:
 // 构造函数 和 内存分配函数
@@ -516,7 +620,10 @@ public:
         rightmost() = m_header;
         m_cnt = 0;
     }
-    ~rb_tree() { clear(); }
+    ~rb_tree() {
+        clear();
+        node_allocator::deallocate(m_header, 1);
+    }
 
     void clear();
     link_type create_node(value_type x);
@@ -533,22 +640,186 @@ public:
 
 public: 
     pair<iterator, bool>insert_unique(const value_type& x);
+    // 带提示的插入：新键紧挨在 hint 之前 (或 hint 为 end() 且新键大于最大键) 时
+    // 不必从根查找，有序或接近有序的输入每次插入均摊 O(1)；否则退化为普通插入
+    iterator insert_unique(iterator hint, const value_type& x);
+    // 区间插入：先按键稳定排序去重 (已有序时跳过排序)，空树或批量相对较大时
+    // 与原有节点归并后 O(n) 自底向上重建，否则逐个插入；
+    // 与 std::map 一致，已有的键保留原节点，区间内键重复时保留最先出现的值
+    template <class InputIter>
+    void insert_unique(InputIter first, InputIter last);
+
+    // 允许键重复的插入，新值放在所有等键值之后
+    iterator insert_equal(const value_type& x);
+    // hint 为 end() 且新键不小于最大键时直接挂在最右节点下，其余情况退化为普通插入
+    iterator insert_equal(iterator hint, const value_type& x);
+    template <class InputIter>
+    void insert_equal(InputIter first, InputIter last)
+    {
+      for (; first != last; ++first)
+        insert_equal(*first);
+    }
 
     iterator  erase(iterator hint);
+    void      erase(iterator first, iterator last);
+    // 删除键等于 key 的所有节点，返回删除的个数
+    size_type erase(const key_type& key);
 private:
     void erase_since(link_type x);
 
+    // 比较两个值的键，供排序使用
+    struct value_compare {
+        rb_tree* tree;
+        bool operator() (const value_type& a, const value_type& b) {
+            return tree->comp(tree->key(a), tree->key(b));
+        }
+    };
+    // 用按中序排好的 n 个节点重建整棵树，节点原有的链接全部重写
+    void build_from_sorted(link_type* nodes, size_type n);
+    // 取 [lo, hi) 的中点为根递归建树；深度为 red_depth 的节点 (不满的最底层) 染红，其余为黑
+    static link_type build_subtree(link_type* nodes, size_type lo, size_type hi,
+                                   link_type parent, int depth, int red_depth);
+
     mystl::pair<mystl::pair<link_type, bool>, bool> 
         get_insert_unique_pos(const key_type& key);
+    // 返回值含义同 get_insert_unique_pos
+    mystl::pair<mystl::pair<link_type, bool>, bool> 
+        get_insert_hint_unique_pos(iterator hint, const key_type& key);
 
     // insert value / insert node
     iterator insert_value_at(link_type x, const value_type& value, bool add_to_left);
 
 // 查找
+// 以下函数在 Compare 带 is_transparent 标记 (如 less<>) 时还接受任意能与键比较的类型 K，
+// 直接拿 K 与节点中的键比较，不构造临时的 key_type
+private:
+  template <class K>
+  link_type lower_bound_node(const K& k);
+  template <class K>
+  link_type upper_bound_node(const K& k);
+  template <class K>
+  iterator find_node(const K& k)
+  {
+    link_type y = lower_bound_node(k);
+    return (y == m_header || comp(k, key(y->value))) ? end() : iterator(y);
+  }
+  template <class K>
+  size_type count_node(const K& k);
+
 public:
-  iterator find(const key_type& key);
+  iterator find(const key_type& k) { return find_node(k); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator find(const K& k) { return find_node(k); }
+  // 第一个键不小于 k 的节点
+  iterator lower_bound(const key_type& k) { return iterator(lower_bound_node(k)); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator lower_bound(const K& k) { return iterator(lower_bound_node(k)); }
+  // 第一个键大于 k 的节点
+  iterator upper_bound(const key_type& k) { return iterator(upper_bound_node(k)); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  iterator upper_bound(const K& k) { return iterator(upper_bound_node(k)); }
+  // 键等于 k 的节点个数
+  size_type count(const key_type& k) { return count_node(k); }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  size_type count(const K& k) { return count_node(k); }
+  pair<iterator, iterator> equal_range(const key_type& k)
+  {
+    return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent>
+  pair<iterator, iterator> equal_range(const K& k)
+  {
+    return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+  }
+  // 对键落在 [lo, hi) 中的每个值按顺序调用 f(value)
+  // 两次下降确定首尾节点，之后只沿节点指针前进，不构造迭代器，每步也不再比较键
+  template <class Function>
+  Function for_each_in_range(const key_type& lo, const key_type& hi, Function f);
+
+// 基于 join 的批量操作 (Blelloch 等, Just Join for Parallel Ordered Sets)
+// 全部直接重连已有节点，不复制也不分配；参数中的另一棵树操作后为空
+public:
+  // 键小于 k 的留在本树，其余移到 right (right 原有内容先被清空)
+  // O(log n)；OrderStat 为 false 时另需 O(min(两部分大小)) 统计节点数
+  void split(const key_type& k, rb_tree& right);
+  // 把 x 和 right 接在本树之后，要求本树的键 < key(x) < right 的键，O(log n)
+  void join(const value_type& x, rb_tree& right);
+  // 把 right 接在本树之后，要求本树的键都小于 right 的键，O(log n)
+  void join(rb_tree& right);
+  // 并 / 交 / 差，结果留在本树；键重复时保留本树的节点
+  // 大小为 n 与 m (m <= n) 的两棵树为 O(m log(n / m + 1))
+  void set_union(rb_tree& other);
+  void set_intersection(rb_tree& other);
+  void set_difference(rb_tree& other);
+
+  // 并行版本：递归的两半交给线程池并发执行
+  // Pool 只需提供 size() 以及可经 ADL 找到的 parallel_invoke(pool, f, g) (见 thread_pool.h)，
+  // 本文件不依赖线程池的实现
+  // 与 set_union 相同，键重复时保留本树的节点
+  template <class Pool>
+  void parallel_set_union(rb_tree& other, Pool& pool);
+  // 与区间 insert_unique 相同：把区间切成若干块并行建树，再两两并行合并；
+  // 键重复时保留原有节点，区间内键重复时保留最先出现的值 (各块内稳定，合并时前一块优先)
+  template <class RandomIter, class Pool>
+  void parallel_insert_unique(RandomIter first, RandomIter last, Pool& pool);
+
+private:
+  // 以 root 为根的子树及其黑高 (根到叶路径上的黑节点数，红色的根不计入)
+  struct join_tree {
+    link_type root;
+    int bh;
+  };
+  static bool join_is_red(link_type x) { return x != nullptr && rb_tree_is_red(x); }
+  static join_tree join_whole(link_type x)
+  {
+    join_tree t = { x, 0 };
+    for (; x != nullptr; x = x->left)
+      if (!rb_tree_is_red(x)) ++t.bh;
+    return t;
+  }
+  // 拆下根节点 t.root，得到左右子树
+  static void join_expose(const join_tree& t, join_tree& l, join_tree& r)
+  {
+    const int bh = t.bh - (rb_tree_is_red(t.root) ? 0 : 1);
+    l.root = t.root->left, l.bh = bh;
+    r.root = t.root->right, r.bh = bh;
+  }
+  static link_type join_make(link_type l, link_type x, link_type r, rb_tree_color_type c);
+  static link_type join_rotate_left(link_type x);
+  static link_type join_rotate_right(link_type x);
+  // 左树比右树高：沿左树右链下降到黑高相同的黑节点处挂上 x，再向上修正连续的红节点
+  static link_type join_right(link_type tl, int bhl, link_type x, link_type tr, int bhr);
+  static link_type join_left(link_type tl, int bhl, link_type x, link_type tr, int bhr);
+  // l 的键 < key(x) < r 的键，返回以 x 连接后的树
+  static join_tree join_trees(join_tree l, link_type x, join_tree r);
+  // 连接两棵树，不需要中间节点
+  static join_tree join_trees(join_tree l, join_tree r);
+  // 拆下最大节点，剩余部分放入 rest
+  static link_type join_split_last(join_tree t, join_tree& rest);
+  // 按 k 拆成键小于 k 和大于 k 的两部分，返回键等于 k 的节点 (没有时为 nullptr)
+  link_type join_split(join_tree t, const key_type& k, join_tree& l, join_tree& r);
+  join_tree join_union(join_tree a, join_tree b, size_type& dup);
+  join_tree join_intersection(join_tree a, join_tree b, size_type& kept);
+  join_tree join_difference(join_tree a, join_tree b, size_type& removed);
+  template <class Pool>
+  join_tree join_union_parallel(join_tree a, join_tree b, size_type& dup, Pool& pool, int depth);
+  template <class RandomIter, class Pool>
+  void build_parallel(RandomIter first, RandomIter last, Pool& pool, int depth);
+  // 并行递归的层数：约为 log2(线程数) + 3，每个线程平均分到 8 个以上的任务；
+  // 只有一个线程时为 0，直接走顺序版本，免去分块再合并的开销
+  template <class Pool>
+  static int parallel_depth(Pool& pool)
+  {
+    if (pool.size() <= 1) return 0;
+    int depth = 3;
+    for (size_t n = pool.size(); n > 1; n >>= 1) ++depth;
+    return depth;
+  }
+  // 以 t 作为整棵树重新挂到 header 下
+  void join_reset(link_type t, size_type n);
 
 //遍历
+public:
   link_type get_header() const { return m_header; }
   void for_each(link_type node) {
     if (node == nullptr) return;
@@ -560,28 +831,46 @@ public:
 // 容量函数
   size_type size() const { return m_cnt; }
 
+// 顺序统计，需要 OrderStat 为 true，均为 O(log n)
+public:
+  // 第 k 小的元素 (从 0 开始)，k >= size() 时返回 end()
+  iterator select(size_type k);
+  // 键小于 key 的元素个数
+  size_type rank(const key_type& key);
+  // 键落在 [lo, hi) 中的元素个数
+  size_type count_range(const key_type& lo, const key_type& hi)
+  {
+    if (!comp(lo, hi)) return 0;
+    return rank(hi) - rank(lo);
+  }
+
 };
 
 // 内存分配析构函数
-template <class Key, class Value, class KeyOfValue, class Compare> 
-typename rb_tree<Key, Value, KeyOfValue, Compare>::link_type
-rb_tree<Key, Value, KeyOfValue, Compare>::create_node(value_type x) 
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::create_node(value_type x) 
 {
     link_type node = node_allocator::allocate();
     construct(&node->value, x);
+    node->left = nullptr;
+    node->right = nullptr;
+    node->parent = nullptr;
+    rb_tree_size_fix(node);
     return node;
 }
 
-template <class Key, class Value, class KeyOfValue, class Compare> 
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
 void 
-rb_tree<Key, Value, KeyOfValue, Compare>::destroy_node(link_type x) {
-    destory(&x->value);
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::destroy_node(link_type x) {
+    if (!std::is_trivially_destructible<value_type>::value)
+        destory(&x->value);
     node_allocator::deallocate(x);
 }
 
 // 插入删除函数 ---------------------------------------------------
-template <class Key, class Value, class KeyOfValue, class Compare> 
-void rb_tree<Key, Value, KeyOfValue, Compare>::clear() {
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::clear() {
     if (m_cnt != 0)
     {
         erase_since(root());
@@ -592,23 +881,33 @@ void rb_tree<Key, Value, KeyOfValue, Compare>::clear() {
     }
 }
 
-// 插入新值，节点键值不允许重复，返回一个 pair，若插入成功，pair 的第二参数为 true，否则为 false
-template <class Key, class Value, class KeyOfValue, class Compare> 
-void rb_tree<Key, Value, KeyOfValue, Compare>::erase_since(link_type x) {
+// 释放以 x 为根的整棵子树，不递归也不用额外的栈：
+// x 有左孩子时右旋，把左孩子转到 x 的位置；没有左孩子时释放 x，转到右孩子
+// 每次旋转都让一个节点永久离开左侧，总共 O(n) 次操作
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::erase_since(link_type x) {
     while (x != nullptr)
     {
-        erase_since(x->right);
-        auto y = x->left;
-        destroy_node(x);
+        link_type y = x->left;
+        if (y != nullptr)
+        {
+            x->left = y->right;
+            y->right = x;
+        }
+        else
+        {
+            y = x->right;
+            destroy_node(x);
+        }
         x = y;
     }
 }
 
 
 // 删除 hint 位置的节点
-template <class Key, class Value, class KeyOfValue, class Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
 erase(iterator hint)
 {
   auto node = hint.node;
@@ -621,10 +920,35 @@ erase(iterator hint)
   return next;
 }
 
+// 删除 [first, last) 区间内的节点
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+erase(iterator first, iterator last)
+{
+  if (first == begin() && last == end())
+  {
+    clear();
+    return;
+  }
+  while (first != last)
+    first = erase(first);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+erase(const key_type& tkey)
+{
+  pair<iterator, iterator> range = equal_range(tkey);
+  const size_type n = m_cnt;
+  erase(range.first, range.second);
+  return n - m_cnt;
+}
+
 
-template <class Key, class Value, class KeyOfValue, class Compare>
-mystl::pair<typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator, bool>
-rb_tree<Key, Value, KeyOfValue, Compare>::
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+mystl::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::iterator, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
 insert_unique(const value_type& value)
 {
   //THROW_LENGTH_ERROR_IF(m_cnt > max_size() - 1, "rb_tree<T, Comp>'s size too big");
@@ -636,10 +960,192 @@ insert_unique(const value_type& value)
   return mystl::make_pair(res.first.first, false);
 }
 
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+insert_unique(iterator hint, const value_type& value)
+{
+  auto res = get_insert_hint_unique_pos(hint, key(value));
+  if (res.second)
+    return insert_value_at(res.first.first, value, res.first.second);
+  if (res.first.first != nullptr)
+    return iterator(res.first.first);  // 与 hint 处的键重复
+  return insert_unique(value).first;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+insert_equal(const value_type& value)
+{
+  auto x = root();
+  auto y = m_header;
+  bool add_to_left = true;  // 树为空时在 header 左边插入
+  const key_type& tkey = key(value);
+  while (x != nullptr)
+  { // 与 x 键值相等时向右走，新值排在等键值之后
+    y = x;
+    add_to_left = comp(tkey, key(x->value));
+    x = add_to_left ? x->left : x->right;
+  }
+  return insert_value_at(y, value, add_to_left);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+insert_equal(iterator hint, const value_type& value)
+{
+  if (hint == end() && m_cnt > 0 && !comp(key(value), key(rightmost()->value)))
+    return insert_value_at(rightmost(), value, false);
+  return insert_equal(value);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+template <class InputIter>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+insert_unique(InputIter first, InputIter last)
+{
+  vector<value_type> values;
+  for (; first != last; ++first)
+    values.push_back(*first);
+  value_type* v = values.begin();
+  size_type n = values.size();
+  if (n == 0) return;
+
+  value_compare vcomp = { this };
+  for (size_type i = 1; i < n; ++i)
+  {
+    if (vcomp(v[i], v[i - 1]))
+    { // 不是非降序才排序；稳定排序保证每组键相等的值仍按输入顺序排列
+      mystl::stable_sort(v, v + n, vcomp);
+      break;
+    }
+  }
+  // 去掉键重复的值，只保留每组的第一个
+  size_type m = 1;
+  for (size_type i = 1; i < n; ++i)
+  {
+    if (vcomp(v[m - 1], v[i]))
+    {
+      if (m != i) v[m] = v[i];
+      ++m;
+    }
+  }
+
+  // 逐个插入约 m * log(size) 次比较，归并重建为 O(size + m)
+  size_type depth = 1;
+  for (size_type s = m_cnt; s > 1; s >>= 1) ++depth;
+  if (m_cnt != 0 && m * depth < m_cnt)
+  {
+    for (size_type i = 0; i < m; ++i)
+      insert_unique(v[i]);
+    return;
+  }
+
+  // 原有节点按中序与新值归并，键重复时保留原节点
+  vector<link_type> nodes;
+  link_type cur = m_cnt == 0 ? m_header : leftmost();
+  size_type i = 0;
+  while (cur != m_header || i < m)
+  {
+    if (cur == m_header || (i < m && comp(key(v[i]), key(cur->value))))
+    {
+      nodes.push_back(create_node(v[i++]));
+    }
+    else
+    {
+      if (i < m && !comp(key(cur->value), key(v[i])))
+        ++i;
+      nodes.push_back(cur);
+      cur = rb_tree_next(cur);
+    }
+  }
+  build_from_sorted(nodes.begin(), nodes.size());
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+build_from_sorted(link_type* nodes, size_type n)
+{
+  // n 个节点按中点划分，0 .. h-1 层全满，h = floor(log2(n))；
+  // n + 1 为 2 的幂时是满二叉树，全部染黑，否则第 h 层染红，每条路径都恰有 h 个黑节点
+  int h = 0;
+  for (size_type s = n; s > 1; s >>= 1) ++h;
+  const bool perfect = ((n + 1) & n) == 0;
+  link_type r = build_subtree(nodes, 0, n, m_header, 0, perfect ? -1 : h);
+  root() = r;
+  leftmost() = n == 0 ? m_header : nodes[0];
+  rightmost() = n == 0 ? m_header : nodes[n - 1];
+  m_cnt = n;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+build_subtree(link_type* nodes, size_type lo, size_type hi, link_type parent, int depth, int red_depth)
+{
+  if (lo >= hi) return nullptr;
+  const size_type mid = lo + (hi - lo) / 2;
+  link_type x = nodes[mid];
+  x->parent = parent;
+  x->color = depth == red_depth ? rb_tree_red : rb_tree_black;
+  x->left = build_subtree(nodes, lo, mid, x, depth + 1, red_depth);
+  x->right = build_subtree(nodes, mid + 1, hi, x, depth + 1, red_depth);
+  rb_tree_size_fix(x);
+  return x;
+}
+
+// get_insert_hint_unique_pos 函数
+// 只检查 hint 与其前一个节点，可以确定位置时 O(1) 返回；
+// 否则返回 ((nullptr, *), false)，由调用者从根查找
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+mystl::pair<mystl::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type, bool>, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::get_insert_hint_unique_pos(iterator hint, const key_type& tkey)
+{
+  link_type pos = hint.node;
+  if (pos == m_header)
+  { // hint 为 end()：新键大于最大键时接在最右节点的右边
+    if (m_cnt > 0 && comp(key(rightmost()->value), tkey))
+      return mystl::make_pair(mystl::make_pair(rightmost(), false), true);
+    return mystl::make_pair(mystl::make_pair(link_type(nullptr), false), false);
+  }
+  if (comp(tkey, key(pos->value)))
+  { // 新键在 hint 之前
+    if (pos == leftmost())
+      return mystl::make_pair(mystl::make_pair(pos, true), true);
+    iterator before(pos);
+    --before;
+    if (comp(key(*before), tkey))
+    { // 落在 (before, hint) 之间：before 无右孩子就接在其右边，否则 hint 必无左孩子
+      if (before.node->right == nullptr)
+        return mystl::make_pair(mystl::make_pair(before.node, false), true);
+      return mystl::make_pair(mystl::make_pair(pos, true), true);
+    }
+    return mystl::make_pair(mystl::make_pair(link_type(nullptr), false), false);
+  }
+  if (comp(key(pos->value), tkey))
+  { // 新键在 hint 之后
+    if (pos == rightmost())
+      return mystl::make_pair(mystl::make_pair(pos, false), true);
+    iterator after(pos);
+    ++after;
+    if (comp(tkey, key(*after)))
+    {
+      if (pos->right == nullptr)
+        return mystl::make_pair(mystl::make_pair(pos, false), true);
+      return mystl::make_pair(mystl::make_pair(after.node, true), true);
+    }
+    return mystl::make_pair(mystl::make_pair(link_type(nullptr), false), false);
+  }
+  // 与 hint 处的键相等
+  return mystl::make_pair(mystl::make_pair(pos, false), false);
+}
+
 // get_insert_unique_pos 函数
-template <class Key, class Value, class KeyOfValue, class Compare> 
-mystl::pair<mystl::pair<typename rb_tree<Key, Value, KeyOfValue, Compare>::link_type, bool>, bool>
-rb_tree<Key, Value, KeyOfValue, Compare>::get_insert_unique_pos(const key_type& tkey)
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+mystl::pair<mystl::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type, bool>, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::get_insert_unique_pos(const key_type& tkey)
 { // 返回一个 pair，第一个值为一个 pair，包含插入点的父节点和一个 bool 表示是否在左边插入，
   // 第二个值为一个 bool，表示是否插入成功
   auto x = root();
@@ -667,15 +1173,15 @@ rb_tree<Key, Value, KeyOfValue, Compare>::get_insert_unique_pos(const key_type&
   { // 表明新节点没有重复
     return mystl::make_pair(mystl::make_pair(y, add_to_left), true);
   }
-  // 进行至此，表示新节点与现有节点键值重复
-  return mystl::make_pair(mystl::make_pair(y, add_to_left), false);
+  // 进行至此，表示新节点与现有节点键值重复，返回重复的节点
+  return mystl::make_pair(mystl::make_pair(j.node, add_to_left), false);
 }
 
 // insert_value_at 函数
 // x 为插入点的父节点， value 为要插入的值，add_to_left 表示是否在左边插入
-template <class Key, class Value, class KeyOfValue, class Compare> 
-typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
 insert_value_at(link_type x, const value_type& value, bool add_to_left)
 {
   link_type node = create_node(value);
@@ -699,16 +1205,69 @@ insert_value_at(link_type x, const value_type& value, bool add_to_left)
     if (rightmost() == x)
       rightmost() = base_node;
   }
+  if (x != m_header)
+    rb_tree_size_path_add(x, root(), 1);
   rb_tree_insert_rebalance(base_node, root());
   ++m_cnt;
   return iterator(node);
 }
 
-// 查找键值为 k 的节点，返回指向它的迭代器
-template <class Key, class Value, class KeyOfValue, class Compare>
-typename rb_tree<Key, Value, KeyOfValue, Compare>::iterator
-rb_tree<Key, Value, KeyOfValue, Compare>::
-find(const key_type& tkey)
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+select(size_type k)
+{
+  static_assert(OrderStat, "select requires an order-statistics rb_tree");
+  if (k >= m_cnt) return end();
+  auto x = root();
+  while (true)
+  {
+    const size_type left = rb_tree_size(x->left);
+    if (k < left)
+    {
+      x = x->left;
+    }
+    else if (k == left)
+    {
+      return iterator(x);
+    }
+    else
+    {
+      k -= left + 1;
+      x = x->right;
+    }
+  }
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+rank(const key_type& tkey)
+{
+  static_assert(OrderStat, "rank requires an order-statistics rb_tree");
+  size_type r = 0;
+  auto x = root();
+  while (x != nullptr)
+  {
+    if (comp(key(x->value), tkey))
+    { // x 及其左子树都小于 key
+      r += rb_tree_size(x->left) + 1;
+      x = x->right;
+    }
+    else
+    {
+      x = x->left;
+    }
+  }
+  return r;
+}
+
+// 第一个键不小于 tkey 的节点，没有时返回 header
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+template <class K>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+lower_bound_node(const K& tkey)
 {
   auto y = m_header;  // 最后一个不小于 key 的节点
   auto x = root();
@@ -723,10 +1282,479 @@ find(const key_type& tkey)
       x = x->right;
     }
   }
-  iterator j = iterator(y);
-  return (j == end() || comp(tkey, key(*j))) ? end() : j;
+  return y;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+template <class K>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+upper_bound_node(const K& tkey)
+{
+  auto y = m_header;  // 最后一个大于 key 的节点
+  auto x = root();
+  while (x != nullptr)
+  {
+    if (comp(tkey, key(x->value)))
+      y = x, x = x->left;
+    else
+      x = x->right;
+  }
+  return y;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+template <class K>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+count_node(const K& tkey)
+{
+  link_type x = lower_bound_node(tkey);
+  size_type n = 0;
+  for (; x != m_header && !comp(tkey, key(x->value)); x = rb_tree_next(x))
+    ++n;
+  return n;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+template <class Function>
+Function rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+for_each_in_range(const key_type& lo, const key_type& hi, Function f)
+{
+  if (!comp(lo, hi)) return f;
+  link_type x = lower_bound_node(lo);
+  const link_type last = lower_bound_node(hi);
+  for (; x != last; x = rb_tree_next(x))
+    f(x->value);
+  return f;
+}
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_make(link_type l, link_type x, link_type r, rb_tree_color_type c)
+{
+  x->left = l;
+  x->right = r;
+  x->color = c;
+  if (l != nullptr) l->parent = x;
+  if (r != nullptr) r->parent = x;
+  rb_tree_size_fix(x);
+  return x;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_rotate_left(link_type x)
+{
+  link_type y = x->right;
+  x->right = y->left;
+  if (y->left != nullptr) y->left->parent = x;
+  y->left = x;
+  x->parent = y;
+  rb_tree_size_rotate(x, y);
+  return y;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_rotate_right(link_type x)
+{
+  link_type y = x->left;
+  x->left = y->right;
+  if (y->right != nullptr) y->right->parent = x;
+  y->right = x;
+  x->parent = y;
+  rb_tree_size_rotate(x, y);
+  return y;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_right(link_type tl, int bhl, link_type x, link_type tr, int bhr)
+{
+  if (bhl == bhr && !join_is_red(tl))
+    return join_make(tl, x, tr, rb_tree_red);
+  const bool black = !rb_tree_is_red(tl);
+  link_type r = join_right(tl->right, bhl - (black ? 1 : 0), x, tr, bhr);
+  join_make(tl->left, tl, r, tl->color);
+  if (black && join_is_red(r) && join_is_red(r->right))
+  { // 黑节点下出现两个连续的红节点：下面的染黑后左旋，子树黑高不变
+    r->right->color = rb_tree_black;
+    return join_rotate_left(tl);
+  }
+  return tl;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_left(link_type tl, int bhl, link_type x, link_type tr, int bhr)
+{
+  if (bhl == bhr && !join_is_red(tr))
+    return join_make(tl, x, tr, rb_tree_red);
+  const bool black = !rb_tree_is_red(tr);
+  link_type l = join_left(tl, bhl, x, tr->left, bhr - (black ? 1 : 0));
+  join_make(l, tr, tr->right, tr->color);
+  if (black && join_is_red(l) && join_is_red(l->left))
+  {
+    l->left->color = rb_tree_black;
+    return join_rotate_right(tr);
+  }
+  return tr;
 }
 
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::join_tree
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_trees(join_tree l, link_type x, join_tree r)
+{
+  // 红色的根先染黑 (黑高加一)，此后连接结果的黑高总是 max(l.bh, r.bh)
+  if (join_is_red(l.root)) l.root->color = rb_tree_black, ++l.bh;
+  if (join_is_red(r.root)) r.root->color = rb_tree_black, ++r.bh;
+  join_tree t;
+  if (l.bh > r.bh)
+  {
+    t.root = join_right(l.root, l.bh, x, r.root, r.bh);
+    t.bh = l.bh;
+  }
+  else if (r.bh > l.bh)
+  {
+    t.root = join_left(l.root, l.bh, x, r.root, r.bh);
+    t.bh = r.bh;
+  }
+  else
+  {
+    t.root = join_make(l.root, x, r.root, rb_tree_red);
+    t.bh = l.bh;
+  }
+  return t;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::join_tree
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_trees(join_tree l, join_tree r)
+{
+  if (l.root == nullptr) return r;
+  if (r.root == nullptr) return l;
+  join_tree rest;
+  link_type x = join_split_last(l, rest);
+  return join_trees(rest, x, r);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_split_last(join_tree t, join_tree& rest)
+{
+  join_tree l, r;
+  join_expose(t, l, r);
+  if (r.root == nullptr)
+  {
+    rest = l;
+    return t.root;
+  }
+  join_tree r_rest;
+  link_type last = join_split_last(r, r_rest);
+  rest = join_trees(l, t.root, r_rest);
+  return last;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_split(join_tree t, const key_type& k, join_tree& l, join_tree& r)
+{
+  if (t.root == nullptr)
+  {
+    l = r = t;
+    return nullptr;
+  }
+  link_type x = t.root;
+  join_tree xl, xr;
+  join_expose(t, xl, xr);
+  if (comp(k, key(x->value)))
+  {
+    join_tree rest;
+    link_type found = join_split(xl, k, l, rest);
+    r = join_trees(rest, x, xr);
+    return found;
+  }
+  if (comp(key(x->value), k))
+  {
+    join_tree rest;
+    link_type found = join_split(xr, k, rest, r);
+    l = join_trees(xl, x, rest);
+    return found;
+  }
+  l = xl;
+  r = xr;
+  return x;
+}
+
+// 拆下 b 的根，按它的键拆分 a，两边分别递归后再连接
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::join_tree
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_union(join_tree a, join_tree b, size_type& dup)
+{
+  if (a.root == nullptr) return b;
+  if (b.root == nullptr) return a;
+  link_type y = b.root;
+  join_tree bl, br, al, ar;
+  join_expose(b, bl, br);
+  link_type x = join_split(a, key(y->value), al, ar);
+  if (x != nullptr)
+  { // 键重复，保留 a 的节点
+    destroy_node(y);
+    ++dup;
+  }
+  else
+  {
+    x = y;
+  }
+  join_tree l = join_union(al, bl, dup);
+  join_tree r = join_union(ar, br, dup);
+  return join_trees(l, x, r);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::join_tree
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_intersection(join_tree a, join_tree b, size_type& kept)
+{
+  if (a.root == nullptr || b.root == nullptr)
+  {
+    erase_since(a.root);
+    erase_since(b.root);
+    join_tree t = { nullptr, 0 };
+    return t;
+  }
+  link_type y = b.root;
+  join_tree bl, br, al, ar;
+  join_expose(b, bl, br);
+  link_type x = join_split(a, key(y->value), al, ar);
+  destroy_node(y);
+  join_tree l = join_intersection(al, bl, kept);
+  join_tree r = join_intersection(ar, br, kept);
+  if (x == nullptr)
+    return join_trees(l, r);
+  ++kept;
+  return join_trees(l, x, r);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::join_tree
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_difference(join_tree a, join_tree b, size_type& removed)
+{
+  if (b.root == nullptr) return a;
+  if (a.root == nullptr)
+  {
+    erase_since(b.root);
+    return a;
+  }
+  link_type y = b.root;
+  join_tree bl, br, al, ar;
+  join_expose(b, bl, br);
+  link_type x = join_split(a, key(y->value), al, ar);
+  destroy_node(y);
+  if (x != nullptr)
+  {
+    destroy_node(x);
+    ++removed;
+  }
+  join_tree l = join_difference(al, bl, removed);
+  join_tree r = join_difference(ar, br, removed);
+  return join_trees(l, r);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_reset(link_type t, size_type n)
+{
+  root() = t;
+  if (t == nullptr)
+  {
+    leftmost() = m_header;
+    rightmost() = m_header;
+  }
+  else
+  {
+    t->parent = m_header;
+    t->color = rb_tree_black;
+    leftmost() = rb_tree_min(t);
+    rightmost() = rb_tree_max(t);
+  }
+  m_cnt = n;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+split(const key_type& k, rb_tree& right)
+{
+  right.clear();
+  if (m_cnt == 0) return;
+  join_tree l, r;
+  link_type x = join_split(join_whole(root()), k, l, r);
+  if (x != nullptr)
+  { // 键等于 k 的节点作为右半部分的最小值
+    join_tree empty = { nullptr, 0 };
+    r = join_trees(empty, x, r);
+  }
+  const size_type n = rb_tree_split_count(l.root, r.root, m_cnt);
+  right.join_reset(r.root, m_cnt - n);
+  join_reset(l.root, n);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join(const value_type& x, rb_tree& right)
+{
+  link_type node = create_node(x);
+  join_tree t = join_trees(join_whole(root()), node, join_whole(right.root()));
+  const size_type n = m_cnt + right.m_cnt + 1;
+  right.join_reset(nullptr, 0);
+  join_reset(t.root, n);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join(rb_tree& right)
+{
+  join_tree t = join_trees(join_whole(root()), join_whole(right.root()));
+  const size_type n = m_cnt + right.m_cnt;
+  right.join_reset(nullptr, 0);
+  join_reset(t.root, n);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+set_union(rb_tree& other)
+{
+  if (this == &other) return;
+  size_type dup = 0;
+  join_tree t = join_union(join_whole(root()), join_whole(other.root()), dup);
+  const size_type n = m_cnt + other.m_cnt - dup;
+  other.join_reset(nullptr, 0);
+  join_reset(t.root, n);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+set_intersection(rb_tree& other)
+{
+  if (this == &other) return;
+  size_type kept = 0;
+  join_tree t = join_intersection(join_whole(root()), join_whole(other.root()), kept);
+  other.join_reset(nullptr, 0);
+  join_reset(t.root, kept);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+set_difference(rb_tree& other)
+{
+  if (this == &other)
+  {
+    clear();
+    return;
+  }
+  size_type removed = 0;
+  join_tree t = join_difference(join_whole(root()), join_whole(other.root()), removed);
+  const size_type n = m_cnt - removed;
+  other.join_reset(nullptr, 0);
+  join_reset(t.root, n);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+template <class Pool>
+typename rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::join_tree
+rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+join_union_parallel(join_tree a, join_tree b, size_type& dup, Pool& pool, int depth)
+{
+  if (depth <= 0 || a.root == nullptr || b.root == nullptr)
+    return join_union(a, b, dup);
+  link_type y = b.root;
+  join_tree bl, br, al, ar;
+  join_expose(b, bl, br);
+  link_type x = join_split(a, key(y->value), al, ar);
+  if (x != nullptr)
+  {
+    destroy_node(y);
+    ++dup;
+  }
+  else
+  {
+    x = y;
+  }
+  // 两半的节点互不相交，可以同时处理
+  join_tree l, r;
+  size_type dup_l = 0, dup_r = 0;
+  parallel_invoke(pool,
+                  [&] { l = join_union_parallel(al, bl, dup_l, pool, depth - 1); },
+                  [&] { r = join_union_parallel(ar, br, dup_r, pool, depth - 1); });
+  dup += dup_l + dup_r;
+  return join_trees(l, x, r);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+template <class Pool>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+parallel_set_union(rb_tree& other, Pool& pool)
+{
+  if (this == &other) return;
+  size_type dup = 0;
+  join_tree t = join_union_parallel(join_whole(root()), join_whole(other.root()), dup,
+                                    pool, parallel_depth(pool));
+  const size_type n = m_cnt + other.m_cnt - dup;
+  other.join_reset(nullptr, 0);
+  join_reset(t.root, n);
+}
+
+// 本树为空：前一半建在本树，后一半建在临时树，然后并入本树
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+template <class RandomIter, class Pool>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+build_parallel(RandomIter first, RandomIter last, Pool& pool, int depth)
+{
+  if (depth <= 0 || last - first < 4096)
+  {
+    insert_unique(first, last);
+    return;
+  }
+  RandomIter mid = first + (last - first) / 2;
+  rb_tree right;
+  parallel_invoke(pool,
+                  [&] { build_parallel(first, mid, pool, depth - 1); },
+                  [&] { right.build_parallel(mid, last, pool, depth - 1); });
+  size_type dup = 0;
+  join_tree t = join_union_parallel(join_whole(root()), join_whole(right.root()), dup,
+                                    pool, depth);
+  const size_type n = m_cnt + right.m_cnt - dup;
+  right.join_reset(nullptr, 0);
+  join_reset(t.root, n);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, bool OrderStat>
+template <class RandomIter, class Pool>
+void rb_tree<Key, Value, KeyOfValue, Compare, OrderStat>::
+parallel_insert_unique(RandomIter first, RandomIter last, Pool& pool)
+{
+  if (m_cnt == 0)
+  {
+    build_parallel(first, last, pool, parallel_depth(pool));
+    return;
+  }
+  rb_tree t;
+  t.build_parallel(first, last, pool, parallel_depth(pool));
+  parallel_set_union(t, pool);
+}
 
 }
 
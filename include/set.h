@@ -5,11 +5,12 @@
 
 namespace mystl {
 
-template <class value_type, class Compare = less<value_type>> 
+// OrderStat 为 true 时支持按名次查询 (select / rank / count_range)
+template <class value_type, class Compare = less<value_type>, bool OrderStat = false> 
 class set {
 private:
   // 以 mystl::rb_tree 作为底层机制
-    typedef mystl::rb_tree<value_type, value_type, identity<value_type>, Compare>  base_type;
+    typedef mystl::rb_tree<value_type, value_type, identity<value_type>, Compare, OrderStat>  base_type;
     base_type m_tree;
 
 public:
@@ -23,16 +24,51 @@ public:
     typedef value_type                                  key_type;
     typedef Compare                                     key_compare;
 
+public:
+    set() {}
+    // 区间构造：排序去重后 O(n) 建树
+    template <class InputIter>
+    set(InputIter first, InputIter last) { m_tree.insert_unique(first, last); }
+
 public:
     // 插入删除
     pair<iterator, bool> insert(const value_type& value)
     {
         return m_tree.insert_unique(value);
     }
+    // 新键紧挨在 hint 之前时 O(1) 定位，有序输入可传 end()
+    iterator insert(iterator hint, const value_type& value)
+    {
+        return m_tree.insert_unique(hint, value);
+    }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { m_tree.insert_unique(first, last); }
     iterator erase(iterator it) { return m_tree.erase(it); }
+    size_type erase(const value_type& val) { return m_tree.erase(val); }
 
     //查找
     iterator find(const value_type& val) { return m_tree.find(val); }
+    size_type count(const value_type& val) { return m_tree.count(val); }
+    iterator lower_bound(const value_type& val) { return m_tree.lower_bound(val); }
+    iterator upper_bound(const value_type& val) { return m_tree.upper_bound(val); }
+    pair<iterator, iterator> equal_range(const value_type& val) { return m_tree.equal_range(val); }
+    // Compare 带 is_transparent 标记 (如 less<>) 时，可以直接用能与键比较的其他类型查找
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& k) { return m_tree.find(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& k) { return m_tree.count(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& k) { return m_tree.lower_bound(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& k) { return m_tree.upper_bound(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<iterator, iterator> equal_range(const K& k) { return m_tree.equal_range(k); }
+    // 对落在 [lo, hi) 中的元素按顺序调用 f(value)
+    template <class Function>
+    Function for_each_in_range(const value_type& lo, const value_type& hi, Function f)
+    {
+        return m_tree.for_each_in_range(lo, hi, f);
+    }
 
     void for_each() { m_tree.for_each(m_tree.get_header()->parent); }
     
@@ -40,6 +76,108 @@ public:
     // 容量函数
     size_type size() const { return m_tree.size(); }
 
+    // 顺序统计，需要 OrderStat 为 true
+    iterator select(size_type k) { return m_tree.select(k); }
+    size_type rank(const value_type& key) { return m_tree.rank(key); }
+    size_type count_range(const value_type& lo, const value_type& hi) { return m_tree.count_range(lo, hi); }
+
+    // 基于 join 的批量操作，重用节点而不复制，参数中的另一个 set 操作后为空
+    // 键小于 k 的留下，其余移到 right
+    void split(const value_type& k, set& right) { m_tree.split(k, right.m_tree); }
+    // 要求本 set 的键 < x < right 的键
+    void join(const value_type& x, set& right) { m_tree.join(x, right.m_tree); }
+    // 要求本 set 的键都小于 right 的键
+    void join(set& right) { m_tree.join(right.m_tree); }
+    // 并 / 交 / 差，结果留在本 set 中，键重复时保留本 set 的元素
+    void set_union(set& other) { m_tree.set_union(other.m_tree); }
+    void set_intersection(set& other) { m_tree.set_intersection(other.m_tree); }
+    void set_difference(set& other) { m_tree.set_difference(other.m_tree); }
+    // 并行版本，pool 一般为 mystl::thread_pool (需包含 thread_pool.h)
+    template <class Pool>
+    void parallel_set_union(set& other, Pool& pool) { m_tree.parallel_set_union(other.m_tree, pool); }
+    // 与 insert(first, last) 结果相同，分块并行建树后并行合并
+    template <class RandomIter, class Pool>
+    void parallel_insert(RandomIter first, RandomIter last, Pool& pool)
+    {
+        m_tree.parallel_insert_unique(first, last, pool);
+    }
+
+    iterator begin() { return m_tree.begin(); }
+    iterator end() { return m_tree.end(); }
+};
+
+// 允许元素重复的 set，相等的元素按插入顺序排列
+template <class value_type, class Compare = less<value_type>, bool OrderStat = false>
+class multiset {
+private:
+    typedef mystl::rb_tree<value_type, value_type, identity<value_type>, Compare, OrderStat>  base_type;
+    base_type m_tree;
+
+public:
+    typedef typename base_type::iterator                iterator;
+    typedef typename base_type::difference_type         difference_type;
+    typedef typename base_type::size_type               size_type;
+    typedef typename base_type::reference               reference;
+    typedef typename base_type::const_reference         const_reference;
+
+    typedef value_type                                  key_type;
+    typedef Compare                                     key_compare;
+
+public:
+    multiset() {}
+    template <class InputIter>
+    multiset(InputIter first, InputIter last) { m_tree.insert_equal(first, last); }
+
+public:
+    // 插入删除
+    iterator insert(const value_type& value)
+    {
+        return m_tree.insert_equal(value);
+    }
+    // 有序输入可传 end()，新值不小于最大值时 O(1) 定位
+    iterator insert(iterator hint, const value_type& value)
+    {
+        return m_tree.insert_equal(hint, value);
+    }
+    template <class InputIter>
+    void insert(InputIter first, InputIter last) { m_tree.insert_equal(first, last); }
+    iterator erase(iterator it) { return m_tree.erase(it); }
+    void erase(iterator first, iterator last) { m_tree.erase(first, last); }
+    // 删除等于 val 的所有元素，返回删除的个数
+    size_type erase(const value_type& val) { return m_tree.erase(val); }
+    void clear() { m_tree.clear(); }
+
+    //查找
+    iterator find(const value_type& val) { return m_tree.find(val); }
+    size_type count(const value_type& val) { return m_tree.count(val); }
+    iterator lower_bound(const value_type& val) { return m_tree.lower_bound(val); }
+    iterator upper_bound(const value_type& val) { return m_tree.upper_bound(val); }
+    pair<iterator, iterator> equal_range(const value_type& val) { return m_tree.equal_range(val); }
+    // Compare 带 is_transparent 标记 (如 less<>) 时，可以直接用能与键比较的其他类型查找
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& k) { return m_tree.find(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& k) { return m_tree.count(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& k) { return m_tree.lower_bound(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& k) { return m_tree.upper_bound(k); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<iterator, iterator> equal_range(const K& k) { return m_tree.equal_range(k); }
+    template <class Function>
+    Function for_each_in_range(const value_type& lo, const value_type& hi, Function f)
+    {
+        return m_tree.for_each_in_range(lo, hi, f);
+    }
+
+    // 容量函数
+    size_type size() const { return m_tree.size(); }
+
+    // 顺序统计，需要 OrderStat 为 true
+    iterator select(size_type k) { return m_tree.select(k); }
+    size_type rank(const value_type& key) { return m_tree.rank(key); }
+    size_type count_range(const value_type& lo, const value_type& hi) { return m_tree.count_range(lo, hi); }
+
     iterator begin() { return m_tree.begin(); }
     iterator end() { return m_tree.end(); }
 };
@@ -0,0 +1,232 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "allocator.h"
+#include <assert.h>
+#include "util.h"
+#include "random.h"
+#include "ws_deque.h"
+namespace mystl {
+
+// 基于 ws_deque 的 work-stealing 线程池
+// 每个 worker 拥有一个 ws_deque：worker 内部派生的任务压入自己的 bottom 端，
+// 空闲时随机挑选 victim 从 top 端窃取；外部线程提交的任务进入注入队列
+class thread_pool {
+    struct task_base {
+        virtual ~task_base() {}
+        virtual void run() = 0;
+    };
+
+    template <class F>
+    struct task_impl : task_base {
+        F f;
+        explicit task_impl(F&& fn) : f(mystl::move(fn)) {}
+        explicit task_impl(const F& fn) : f(fn) {}
+        void run() override { f(); }
+    };
+
+    struct worker {
+        ws_deque<task_base*>    tasks;
+        std::thread             th;
+    };
+
+public:
+    typedef size_t          size_type;
+
+public:
+    explicit thread_pool(size_type n = std::thread::hardware_concurrency());
+    ~thread_pool();
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator= (const thread_pool&) = delete;
+
+    size_type size() const { return m_nworkers; }
+
+    // 提交一个任务，worker 线程内提交时压入自己的队列
+    template <class F>
+    void submit(F&& f);
+
+    // 尝试执行一个待处理任务，task_group::wait 用它在等待时帮忙干活
+    bool run_one();
+
+    // 当前线程所属的 worker 编号，非本池线程返回 -1
+    int current_worker() const { return tl_pool == this ? tl_index : -1; }
+
+private:
+    void worker_loop(int index);
+    void push_task(task_base* t);
+    task_base* find_task(int self);
+
+private:
+    worker*                     m_workers;
+    size_type                   m_nworkers;
+    std::atomic<bool>           m_stop;
+    std::atomic<int>            m_sleeping;
+
+    std::mutex                  m_mutex;     // 串行化注入队列的 push 与休眠
+    std::condition_variable     m_cond;
+    // 注入队列：外部线程持锁 push (同一时刻只有一个 owner)，worker 无锁 steal，先进先出
+    // 环形缓冲区只随队列长度的峰值增长，出队的槽位会被重用
+    ws_deque<task_base*>        m_inject;
+
+    static thread_local thread_pool*    tl_pool;
+    static thread_local int             tl_index;
+};
+
+inline thread_local thread_pool* thread_pool::tl_pool = nullptr;
+inline thread_local int thread_pool::tl_index = -1;
+
+inline thread_pool::thread_pool(size_type n)
+    : m_nworkers(n == 0 ? 1 : n), m_stop(false), m_sleeping(0)
+{
+    m_workers = new worker[m_nworkers];
+    for (size_type i = 0; i < m_nworkers; ++i)
+        m_workers[i].th = std::thread(&thread_pool::worker_loop, this, static_cast<int>(i));
+}
+
+inline thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop.store(true);
+    }
+    m_cond.notify_all();
+    for (size_type i = 0; i < m_nworkers; ++i)
+        m_workers[i].th.join();
+    // 停止后残留的任务直接丢弃
+    task_base* t;
+    for (size_type i = 0; i < m_nworkers; ++i)
+        while (m_workers[i].tasks.pop(t)) delete t;
+    while (m_inject.steal(t)) delete t;
+    delete[] m_workers;
+}
+
+template <class F>
+void thread_pool::submit(F&& f) {
+    typedef typename remove_reference<F>::type fn_type;
+    push_task(new task_impl<fn_type>(mystl::forward<F>(f)));
+}
+
+inline void thread_pool::push_task(task_base* t) {
+    if (tl_pool == this) {
+        m_workers[tl_index].tasks.push(t);
+        if (m_sleeping.load(std::memory_order_relaxed) > 0)
+            m_cond.notify_one();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_inject.push(t);
+    }
+    m_cond.notify_one();
+}
+
+// 依次尝试：自己的队列 -> 随机 victim -> 注入队列
+inline thread_pool::task_base* thread_pool::find_task(int self) {
+    task_base* t = nullptr;
+    if (self >= 0 && m_workers[self].tasks.pop(t))
+        return t;
+
+    const uint32_t n = static_cast<uint32_t>(m_nworkers);
+    uint32_t start = thread_rand()(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        uint32_t victim = start + i < n ? start + i : start + i - n;
+        if (static_cast<int>(victim) != self && m_workers[victim].tasks.steal(t))
+            return t;
+    }
+
+    if (m_inject.steal(t))
+        return t;
+    return nullptr;
+}
+
+inline bool thread_pool::run_one() {
+    task_base* t = find_task(current_worker());
+    if (t == nullptr) return false;
+    t->run();
+    delete t;
+    return true;
+}
+
+inline void thread_pool::worker_loop(int index) {
+    tl_pool = this;
+    tl_index = index;
+    int idle = 0;
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        if (run_one()) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < 64) {
+            std::this_thread::yield();
+            continue;
+        }
+        // 长时间没有任务，进入休眠；带超时以防错过其它 worker 派生任务时的唤醒
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_stop.load() || !m_inject.empty()) continue;
+        m_sleeping.fetch_add(1);
+        m_cond.wait_for(lock, std::chrono::milliseconds(1));
+        m_sleeping.fetch_sub(1);
+        idle = 0;
+    }
+    tl_pool = nullptr;
+    tl_index = -1;
+}
+
+
+// fork-join 任务组
+// run() 派生子任务，wait() 在计数归零前持续帮忙执行池中的任务，因此可在 worker 内递归使用
+class task_group {
+public:
+    explicit task_group(thread_pool& pool) : m_pool(pool), m_pending(0) {}
+    ~task_group() { wait(); }
+    task_group(const task_group&) = delete;
+    task_group& operator= (const task_group&) = delete;
+
+    template <class F>
+    void run(F&& f) {
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        typedef typename remove_reference<F>::type fn_type;
+        m_pool.submit(done_wrapper<fn_type>(mystl::forward<F>(f), &m_pending));
+    }
+
+    void wait() {
+        while (m_pending.load(std::memory_order_acquire) != 0) {
+            if (!m_pool.run_one())
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    template <class F>
+    struct done_wrapper {
+        F                   f;
+        std::atomic<long>*  pending;
+        done_wrapper(F&& fn, std::atomic<long>* p) : f(mystl::move(fn)), pending(p) {}
+        done_wrapper(const F& fn, std::atomic<long>* p) : f(fn), pending(p) {}
+        void operator() () {
+            f();
+            pending->fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+private:
+    thread_pool&        m_pool;
+    std::atomic<long>   m_pending;
+};
+
+// 并行执行 f 和 g，两者都完成后返回：g 派生为任务，f 在当前线程上执行
+// rb_tree 等容器的并行算法经 ADL 调用它，因此不必包含本文件
+template <class F, class G>
+void parallel_invoke(thread_pool& pool, F&& f, G&& g) {
+    task_group tg(pool);
+    tg.run(mystl::forward<G>(g));
+    f();
+    tg.wait();
+}
+
+}
+#endif
@@ -29,6 +29,10 @@ public:
     pair<iterator, bool> insert(const value_type& val) { return c.insert_unique(val); }
     
     iterator find(const key_type& key) { return c.find(key); }
+    // KeyEqual 和 Hash 都是透明版本 (equal_to<> 与 hash<>) 时，可以用与键可比较的其他类型查找
+    template <class K, class E = KeyEqual, class H = Hash,
+              class = typename E::is_transparent, class = typename H::is_transparent>
+    iterator find(const K& key) { return c.find(key); }
     
 private:
     container c;
@@ -0,0 +1,321 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include "iterator.h"
+#include "allocator.h"
+#include "construct.h"
+#include "util.h"
+#include <assert.h>
+namespace mystl {
+
+// 每个节点默认约 512 字节的元素，至少 8 个
+template <class T>
+struct unrolled_node_capacity {
+    static constexpr size_t value = sizeof(T) <= 64 ? 512 / sizeof(T) : 8;
+};
+
+// 头节点只需要链接信息，不带元素存储
+struct __unrolled_node_base {
+    typedef __unrolled_node_base* base_ptr;
+    base_ptr prev;
+    base_ptr next;
+    size_t count;
+};
+
+template <class T, size_t N>
+struct __unrolled_node : public __unrolled_node_base {
+    alignas(T) unsigned char storage[N * sizeof(T)];
+
+    T* data() { return reinterpret_cast<T*>(storage); }
+};
+
+
+// 迭代器：节点指针 + 节点内下标，end() 为 (头节点, 0)
+template <class T, size_t N>
+struct unrolled_list_iterator : public iterator<bidirectional_iterator_tag, T> {
+    typedef __unrolled_node_base*               base_ptr;
+    typedef __unrolled_node<T, N>*              link_type;
+    typedef unrolled_list_iterator              self;
+
+    typedef typename self::iterator_category            iterator_category;
+    typedef typename self::value_type                   value_type;
+    typedef typename self::pointer                      pointer;
+    typedef typename self::reference                    reference;
+    typedef typename self::const_reference              const_reference;
+    typedef typename self::difference_type              difference_type;
+
+    base_ptr node;
+    size_t   idx;
+
+    unrolled_list_iterator(base_ptr n, size_t i) : node(n), idx(i) {}
+    unrolled_list_iterator(const unrolled_list_iterator& rhs) : node(rhs.node), idx(rhs.idx) {}
+    unrolled_list_iterator& operator= (const unrolled_list_iterator& rhs) {
+        node = rhs.node;
+        idx = rhs.idx;
+        return *this;
+    }
+
+    bool operator== (const self& rhs) const { return node == rhs.node && idx == rhs.idx; }
+    bool operator!= (const self& rhs) const { return !(*this == rhs); }
+
+    reference operator* () const { return static_cast<link_type>(node)->data()[idx]; }
+    pointer operator-> () const { return &operator*(); }
+
+    self& operator++ () {
+        if (++idx == node->count) {
+            node = node->next;
+            idx = 0;
+        }
+        return *this;
+    }
+    self operator++ (int) {
+        self temp = *this;
+        ++*this;
+        return temp;
+    }
+    self& operator-- () {
+        if (idx == 0) {
+            node = node->prev;
+            idx = node->count;
+        }
+        --idx;
+        return *this;
+    }
+    self operator-- (int) {
+        self temp = *this;
+        --*this;
+        return temp;
+    }
+};
+
+
+// unrolled linked list
+// 每个节点存放至多 N 个连续元素：遍历时每个 cache line 覆盖多个元素，
+// 插入删除只移动所在节点内的元素。节点满时对半分裂；
+// 删除后节点少于 N/4 个元素时，若与相邻节点合计不超过 3N/4 则合并
+template <class T, size_t N = unrolled_node_capacity<T>::value>
+class unrolled_list {
+    static_assert(N >= 4, "unrolled_list needs at least 4 elements per node");
+
+public:
+    typedef T                       value_type;
+    typedef T*                      pointer;
+    typedef const T*                const_pointer;
+    typedef T&                      reference;
+    typedef const T&                const_reference;
+    typedef size_t                  size_type;
+    typedef ptrdiff_t               difference_type;
+
+    typedef unrolled_list_iterator<T, N>    iterator;
+    typedef __unrolled_node<T, N>           list_node;
+    typedef list_node*                      link_type;
+    typedef __unrolled_node_base*           base_ptr;
+    typedef alloc<list_node>                node_allocator;
+
+    static constexpr size_type node_capacity   = N;
+    static constexpr size_type merge_threshold = N / 4;
+    static constexpr size_type merge_limit     = N * 3 / 4;
+
+public:
+    unrolled_list() { init(); }
+    unrolled_list(const unrolled_list& rhs) {
+        init();
+        for (base_ptr p = rhs.m_header.next; p != &rhs.m_header; p = p->next) {
+            link_type n = static_cast<link_type>(p);
+            for (size_type i = 0; i < n->count; ++i)
+                push_back(n->data()[i]);
+        }
+    }
+    unrolled_list& operator= (const unrolled_list& rhs) {
+        if (this != &rhs) {
+            clear();
+            for (base_ptr p = rhs.m_header.next; p != &rhs.m_header; p = p->next) {
+                link_type n = static_cast<link_type>(p);
+                for (size_type i = 0; i < n->count; ++i)
+                    push_back(n->data()[i]);
+            }
+        }
+        return *this;
+    }
+    ~unrolled_list() { clear(); }
+
+    iterator begin() { return iterator(m_header.next, 0); }
+    iterator end() { return iterator(&m_header, 0); }
+    bool empty() const { return m_size == 0; }
+    size_type size() const { return m_size; }
+    reference front() { return *begin(); }
+    reference back() { return *(--end()); }
+
+    iterator insert(iterator it, const_reference x);
+    iterator erase(iterator it);
+    void clear();
+    void push_back(const_reference x) { insert(end(), x); }
+    void push_front(const_reference x) { insert(begin(), x); }
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(--end()); }
+
+    // 对每个元素调用 f，按节点批量遍历，不经过迭代器
+    template <class F>
+    void for_each(F f) {
+        for (base_ptr p = m_header.next; p != &m_header; p = p->next) {
+            T* d = static_cast<link_type>(p)->data();
+            for (size_type i = 0, n = p->count; i < n; ++i)
+                f(d[i]);
+        }
+    }
+
+private:
+    void init() {
+        m_header.prev = &m_header;
+        m_header.next = &m_header;
+        m_header.count = 0;
+        m_size = 0;
+    }
+
+    // 在 pos 之前链入一个空节点
+    link_type create_node_before(base_ptr pos) {
+        link_type n = node_allocator::allocate();
+        n->count = 0;
+        n->next = pos;
+        n->prev = pos->prev;
+        pos->prev->next = n;
+        pos->prev = n;
+        return n;
+    }
+    void destroy_node(link_type n) {
+        n->prev->next = n->next;
+        n->next->prev = n->prev;
+        node_allocator::deallocate(n);
+    }
+
+    // 把 src 的 [first, first + cnt) 移动构造到 dst 末尾
+    static void move_back(link_type dst, link_type src, size_type first, size_type cnt) {
+        T* s = src->data() + first;
+        T* d = dst->data() + dst->count;
+        for (size_type i = 0; i < cnt; ++i) {
+            construct(d + i, mystl::move(s[i]));
+            destory(s + i);
+        }
+        dst->count += cnt;
+    }
+
+    // 节点内下标 idx 处插入，调用前保证节点未满；x 被移走
+    static void insert_in_node(link_type n, size_type idx, value_type& x) {
+        T* d = n->data();
+        if (idx == n->count) {
+            construct(d + idx, mystl::move(x));
+        }
+        else {
+            construct(d + n->count, mystl::move(d[n->count - 1]));
+            for (size_type i = n->count - 1; i > idx; --i)
+                d[i] = mystl::move(d[i - 1]);
+            d[idx] = mystl::move(x);
+        }
+        ++n->count;
+    }
+
+    // 节点元素过少时与相邻节点合并，返回合并后原 idx 处元素所在位置
+    iterator try_merge(link_type n, size_type idx);
+
+private:
+    __unrolled_node_base m_header;
+    size_type            m_size;
+};
+
+template <class T, size_t N>
+typename unrolled_list<T, N>::iterator
+unrolled_list<T, N>::insert(iterator it, const_reference x) {
+    // x 可能引用本表中的元素，分裂和移动会使它失效，先复制一份
+    value_type tmp(x);
+    base_ptr pos = it.node;
+    size_type idx = it.idx;
+    if (pos == &m_header) {
+        // end()：追加到最后一个节点，满了就新开一个
+        pos = m_header.prev;
+        if (pos == &m_header || pos->count == N)
+            pos = create_node_before(&m_header);
+        idx = pos->count;
+    }
+    else if (idx == 0 && pos->prev != &m_header && pos->prev->count < N) {
+        // 插在节点开头时优先放进前一个节点的尾部，避免移动
+        pos = pos->prev;
+        idx = pos->count;
+    }
+
+    link_type n = static_cast<link_type>(pos);
+    if (n->count == N) {
+        // 对半分裂
+        link_type m = create_node_before(n->next);
+        const size_type half = N / 2;
+        move_back(m, n, half, N - half);
+        n->count = half;
+        if (idx > half) {
+            n = m;
+            idx -= half;
+        }
+    }
+    insert_in_node(n, idx, tmp);
+    ++m_size;
+    return iterator(n, idx);
+}
+
+template <class T, size_t N>
+typename unrolled_list<T, N>::iterator
+unrolled_list<T, N>::erase(iterator it) {
+    assert(it.node != &m_header);
+    link_type n = static_cast<link_type>(it.node);
+    size_type idx = it.idx;
+    T* d = n->data();
+    for (size_type i = idx; i + 1 < n->count; ++i)
+        d[i] = mystl::move(d[i + 1]);
+    destory(d + n->count - 1);
+    --n->count;
+    --m_size;
+
+    if (n->count == 0) {
+        base_ptr next = n->next;
+        destroy_node(n);
+        return iterator(next, 0);
+    }
+    if (n->count < merge_threshold)
+        return try_merge(n, idx);
+    if (idx == n->count)
+        return iterator(n->next, 0);
+    return iterator(n, idx);
+}
+
+template <class T, size_t N>
+typename unrolled_list<T, N>::iterator
+unrolled_list<T, N>::try_merge(link_type n, size_type idx) {
+    if (n->next != &m_header && n->count + n->next->count <= merge_limit) {
+        link_type next = static_cast<link_type>(n->next);
+        move_back(n, next, 0, next->count);
+        destroy_node(next);
+    }
+    else if (n->prev != &m_header && n->prev->count + n->count <= merge_limit) {
+        link_type prev = static_cast<link_type>(n->prev);
+        idx += prev->count;
+        move_back(prev, n, 0, n->count);
+        destroy_node(n);
+        n = prev;
+    }
+    if (idx == n->count)
+        return iterator(n->next, 0);
+    return iterator(n, idx);
+}
+
+template <class T, size_t N>
+void unrolled_list<T, N>::clear() {
+    base_ptr p = m_header.next;
+    while (p != &m_header) {
+        base_ptr next = p->next;
+        link_type n = static_cast<link_type>(p);
+        destory(n->data(), n->data() + n->count);
+        node_allocator::deallocate(n);
+        p = next;
+    }
+    init();
+}
+
+}
+#endif
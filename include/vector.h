@@ -24,14 +24,17 @@ public:
     typedef T* iterator;
 
 public:
-    vector() : _finish(nullptr), _first(nullptr), _end_store(nullptr) {};
+    vector() : _first(nullptr), _finish(nullptr), _end_store(nullptr) {};
     ~vector() { 
         mystl::destory(_first, _finish); 
         _deallocate();
         _finish = _first = _end_store = nullptr;
     };
     vector(size_type n, T&& x) {
-        _fill_allocate(n, forward<T>(x));
+        _fill_allocate(n, mystl::forward<T>(x));
+    }
+    vector(size_type n, const T& x) {
+        _fill_allocate(n, T(x));
     }
     vector(size_type n) {
         _fill_allocate(n, value_type());
@@ -41,9 +44,12 @@ public:
         rhs._finish = nullptr;
         rhs._end_store = nullptr;
     }
-    vector(vector& rhs) {
-        _fill_allocate(rhs.size(), value_type());
-        initialize_copy(rhs._first, rhs._finish, _first);
+    vector(const vector& rhs) : _first(nullptr), _finish(nullptr), _end_store(nullptr) {
+        if (rhs.empty()) return;
+        _first = _finish = Alloc::allocate(rhs.size());
+        for (const_pointer p = rhs._first; p != rhs._finish; ++p, ++_finish)
+            mystl::construct(_finish, *p);
+        _end_store = _finish;
     }
 
     size_type size() const { return _finish - _first; }
@@ -57,16 +63,24 @@ public:
     reference front() { return *_first; }
     reference back() { return *(_finish - 1); }
     void push_back(T&& x);
-    void push_back(T& x);
+    void push_back(const T& x);
     void pop_back();
+    // 销毁所有元素，保留容量
+    void clear() {
+        destory(_first, _finish);
+        _finish = _first;
+    }
 
     template<class... Args>
     void emplace_back(Args &&...args);
 
     //如果在begin()插入相当于push_front();
     iterator insert(iterator it, const T& x);
-    iterator insert(iterator it, size_type n, T& x);
+    iterator insert(iterator it, size_type n, const T& x);
     iterator insert(iterator it, size_type n, T&& x);
+    // 删除元素，后面的元素前移，返回指向被删元素之后的迭代器
+    iterator erase(iterator it);
+    iterator erase(iterator first, iterator last);
 
 	// swap
 	void swap(vector &rhs) noexcept;
@@ -103,7 +117,7 @@ private:
 template<class T, class Alloc>
 void vector<T, Alloc>::_fill_allocate(int n, T&& x) { 
         iterator p = Alloc::allocate(n); 
-        mystl::initialize_fill_n(p, n, forward<T>(x));
+        mystl::initialize_fill_n(p, n, mystl::forward<T>(x));
         _first = p;
         _finish = p + n;
         _end_store = _finish;
@@ -141,7 +155,7 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(iterator it, const
 
 template<class T, class Alloc>
 typename vector<T, Alloc>::iterator vector<T, Alloc>::
-  insert(iterator it, size_type n, T& x) {
+  insert(iterator it, size_type n, const T& x) {
     assert(n > 0);
     if (capacity() < size() + n) {
 
@@ -199,7 +213,7 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::
         if (capacity() == 0) {
             _finish = _first = Alloc::allocate(1);
             _end_store = _finish + 1;
-            return insert(end(), n, move(x));
+            return insert(end(), n, mystl::move(x));
         }
 
         int cnt = capacity();
@@ -219,32 +233,51 @@ typename vector<T, Alloc>::iterator vector<T, Alloc>::
 
 
         it = _first + off;
-        return insert(it, n, move(x));
+        return insert(it, n, mystl::move(x));
     }
     
     size_type elem_after = _finish - it;
 
     if (elem_after <= n) {
         initialize_copy(it, _finish, it + n);
-        initialize_fill_n(it, n, move(x));
+        initialize_fill_n(it, n, mystl::move(x));
         _finish += n;
     }
     else {
         initialize_copy_r(it, _finish, it + n);
-        initialize_fill_n(it, n, move(x));
+        initialize_fill_n(it, n, mystl::move(x));
         _finish += n;
     }
     return it;
 }
 
 template<class T, class Alloc>
-void vector<T, Alloc>::push_back(T& x) {
+typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(iterator it) {
+    assert(it >= _first && it < _finish);
+    return erase(it, it + 1);
+}
+
+template<class T, class Alloc>
+typename vector<T, Alloc>::iterator vector<T, Alloc>::
+  erase(iterator first, iterator last) {
+    assert(first >= _first && first <= last && last <= _finish);
+    if (first == last) return first;
+    iterator dst = first;
+    for (iterator src = last; src != _finish; ++src, ++dst)
+        *dst = mystl::move(*src);
+    destory(dst, _finish);
+    _finish = dst;
+    return first;
+}
+
+template<class T, class Alloc>
+void vector<T, Alloc>::push_back(const T& x) {
     insert(end(), 1u, x);
 }
 
 template<class T, class Alloc>
 void vector<T, Alloc>::push_back(T&& x) {
-    insert(end(), 1u, move(x));
+    insert(end(), 1u, mystl::move(x));
 }
 
 
@@ -278,9 +311,10 @@ void vector<T, Alloc>::reserve(size_type n)
         auto temp = Alloc::allocate(n);
         initialize_copy(_first, _finish, temp);
         destory(_first, _finish);
-        Alloc::deallocate(&*(_first), _finish - _first);
+        _deallocate();
         _first = temp;
-        _finish = temp + n;
+        _finish = temp + old_size;
+        _end_store = temp + n;
     }
 }
 
@@ -318,7 +352,6 @@ void vector<T, Alloc>::swap (vector<T, Alloc> &rhs) noexcept
 		mystl::swap(_first, rhs._first);
 		mystl::swap(_finish, rhs._finish);
 		mystl::swap(_end_store, rhs._end_store);
-        printf("swap:  first : %p, %p \n", this->_first, rhs._first);
 	}
 }
 
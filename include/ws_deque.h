@@ -0,0 +1,137 @@
+#ifndef WS_DEQUE_H
+#define WS_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+namespace mystl {
+
+// Chase-Lev work-stealing deque
+// owner 线程在 bottom 端 push / pop，其它线程 (thief) 从 top 端 steal
+// 内存序参照 Lê et al. "Correct and Efficient Work-Stealing for Weak Memory Models"
+template <class T>
+class ws_deque {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ws_deque<T> requires a trivially copyable T (usually a pointer)");
+
+    // 环形缓冲区，容量为 2 的幂
+    struct ring {
+        ptrdiff_t           capacity;
+        ptrdiff_t           mask;
+        std::atomic<T>*     slots;
+        ring*               prev;   // 扩容后旧的缓冲区，thief 可能仍在读，析构时统一释放
+
+        explicit ring(ptrdiff_t cap)
+            : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]), prev(nullptr) {}
+        ~ring() { delete[] slots; }
+
+        T get(ptrdiff_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(ptrdiff_t i, T x) { slots[i & mask].store(x, std::memory_order_relaxed); }
+
+        ring* grow(ptrdiff_t top, ptrdiff_t bottom) {
+            ring* r = new ring(capacity << 1);
+            for (ptrdiff_t i = top; i != bottom; ++i)
+                r->put(i, get(i));
+            r->prev = this;
+            return r;
+        }
+    };
+
+public:
+    typedef T           value_type;
+    typedef size_t      size_type;
+
+public:
+    explicit ws_deque(size_type capacity = 1024) {
+        ptrdiff_t cap = 1;
+        while (cap < static_cast<ptrdiff_t>(capacity)) cap <<= 1;
+        m_top.store(0, std::memory_order_relaxed);
+        m_bottom.store(0, std::memory_order_relaxed);
+        m_ring.store(new ring(cap), std::memory_order_relaxed);
+    }
+    ~ws_deque() {
+        ring* r = m_ring.load(std::memory_order_relaxed);
+        while (r) {
+            ring* p = r->prev;
+            delete r;
+            r = p;
+        }
+    }
+    ws_deque(const ws_deque&) = delete;
+    ws_deque& operator= (const ws_deque&) = delete;
+
+    // 近似值，仅用于统计 / 调度提示
+    size_type size() const {
+        ptrdiff_t b = m_bottom.load(std::memory_order_relaxed);
+        ptrdiff_t t = m_top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_type>(b - t) : 0;
+    }
+    bool empty() const { return size() == 0; }
+
+    // 以下两个函数只能由 owner 调用
+    void push(T x);
+    bool pop(T& out);
+
+    // 任意线程可调用，失败 (空或竞争失败) 返回 false
+    bool steal(T& out);
+
+private:
+    alignas(64) std::atomic<ptrdiff_t> m_top;
+    alignas(64) std::atomic<ptrdiff_t> m_bottom;
+    std::atomic<ring*>                 m_ring;
+};
+
+template <class T>
+void ws_deque<T>::push(T x) {
+    ptrdiff_t b = m_bottom.load(std::memory_order_relaxed);
+    ptrdiff_t t = m_top.load(std::memory_order_acquire);
+    ring* r = m_ring.load(std::memory_order_relaxed);
+    if (b - t > r->capacity - 1) {
+        r = r->grow(t, b);
+        m_ring.store(r, std::memory_order_release);
+    }
+    r->put(b, x);
+    // 原论文为 release fence + relaxed store，这里直接用 release store，x86 上开销相同
+    m_bottom.store(b + 1, std::memory_order_release);
+}
+
+template <class T>
+bool ws_deque<T>::pop(T& out) {
+    ptrdiff_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+    ring* r = m_ring.load(std::memory_order_relaxed);
+    m_bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ptrdiff_t t = m_top.load(std::memory_order_relaxed);
+    if (t > b) {
+        // 已经为空
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+    out = r->get(b);
+    if (t == b) {
+        // 只剩最后一个元素，与 thief 竞争
+        bool won = m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                 std::memory_order_relaxed);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+template <class T>
+bool ws_deque<T>::steal(T& out) {
+    ptrdiff_t t = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ptrdiff_t b = m_bottom.load(std::memory_order_acquire);
+    if (t >= b) return false;
+    ring* r = m_ring.load(std::memory_order_acquire);
+    T x = r->get(t);
+    if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed))
+        return false;
+    out = x;
+    return true;
+}
+
+}
+#endif